@@ -7,6 +7,7 @@
 #include <ostream>
 #include <set>
 #include <string>
+#include <unordered_map>
 
 namespace dunedaq {
 namespace oksdalgen {
@@ -39,6 +40,127 @@ class ClassInfo {
 
 };
 
+  /**
+   *  The GenerationOptions describes optional features of the generated code.
+   */
+
+struct GenerationOptions
+{
+  bool m_typed_enums = false;        // single-value enumeration attributes are stored as enum class
+  bool m_chrono_dates = false;       // date and time attributes are stored as std::chrono::sys_days and sys_seconds
+  bool m_compact_layout = false;     // data members are ordered by alignment and bool attributes are packed into bitfields
+  bool m_reflection = false;         // classes describe their attributes and relationships by constexpr tables
+  bool m_snapshot = false;           // classes write and read their data to and from binary snapshot
+  bool m_json = false;               // classes write their data in JSON format
+  bool m_lazy_relationships = false; // relationships are resolved on first access instead of init()
+  bool m_preload = false;            // generate parallel preloader of all objects of generated classes
+  bool m_prelude = false;            // headers include shared prelude; generate umbrella header and list of precompiled headers
+  bool m_fwd_header = false;         // generate header with forward declarations of all classes; it is used by generated headers
+  bool m_extern_templates = false;   // conffwk templates are explicitly instantiated by implementation files of classes
+  std::map<std::string, unsigned long> m_size_budget;  // maximum sizeof() of generated classes checked at build time
+  std::set<std::string> m_lazy_attributes;             // classes decoding attributes on first access instead of init()
+
+  std::string
+  str() const
+  {
+    std::string s;
+
+    if (m_typed_enums)
+      s += " typed-enums";
+
+    if (m_chrono_dates)
+      s += " chrono-dates";
+
+    if (m_compact_layout)
+      s += " compact-layout";
+
+    if (m_reflection)
+      s += " reflection";
+
+    if (m_snapshot)
+      s += " snapshot";
+
+    if (m_json)
+      s += " json";
+
+    if (m_lazy_relationships)
+      s += " lazy-relationships";
+
+    if (m_preload)
+      s += " preload";
+
+    if (m_prelude)
+      s += " prelude";
+
+    if (m_fwd_header)
+      s += " fwd-header";
+
+    if (m_extern_templates)
+      s += " extern-templates";
+
+    if (!m_lazy_attributes.empty())
+      {
+        s += " lazy-attributes=";
+
+        for (const auto& x : m_lazy_attributes)
+          {
+            if (s.back() != '=')
+              s.push_back(',');
+
+            s += x;
+          }
+      }
+
+    return s;
+  }
+};
+
+
+  /**
+   *  The DataMember describes data member of generated class.
+   *  Its size and alignment are estimated for 64-bit platforms.
+   */
+
+struct DataMember
+{
+  std::string m_type;          // C++ type
+  std::string m_name;          // name without "m_" prefix
+  unsigned int m_size;         // estimated size in bytes
+  unsigned int m_alignment;    // estimated alignment in bytes
+  bool m_is_bit;               // packed into 1-bit bitfield
+};
+
+
+  /**
+   *  The ClassNamesIndex maps names of all classes known to the OKS kernel
+   *  to the classes. It is built once to search classes used in method prototypes.
+   */
+
+typedef std::unordered_map<std::string, oks::OksClass *> ClassNamesIndex;
+
+
+  /**
+   *  The ExternalClassIndex describes classes which are not generated:
+   *  the user-defined classes (-D) and the classes found in oksdalgen.info
+   *  files of include directories (-I). It is built once before generation.
+   */
+
+struct ExternalClassIndex
+{
+  struct Entry
+  {
+    std::string m_namespace;
+    std::string m_include_prefix;
+    std::string m_source;
+  };
+
+  typedef std::unordered_map<std::string, Entry> Map;
+
+  Map m_user_classes;
+  Map m_info_classes;
+  bool m_info_classes_registered = false;
+};
+
 struct NameSpaceInfo
 {
   std::set<std::string> m_classes;
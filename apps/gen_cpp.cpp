@@ -0,0 +1,2917 @@
+#include "class_info.hpp"
+
+#include "oks/kernel.hpp"
+#include "oks/class.hpp"
+#include "oks/attribute.hpp"
+#include "oks/relationship.hpp"
+#include "oks/method.hpp"
+
+#include <stdlib.h>
+#include <ctype.h>
+
+#include <algorithm>
+#include <string>
+#include <list>
+#include <map>
+#include <set>
+#include <iostream>
+#include <vector>
+
+using namespace dunedaq;
+using namespace dunedaq::oksdalgen;
+
+  // declare external functions
+
+extern std::string alnum_name(const std::string& in);
+extern std::string get_fwd_header_name(const std::string& cpp_ns_name);
+extern std::string capitalize_name(const std::string& in);
+extern void print_description(std::ostream& s, const std::string& text, const char * dx);
+extern void print_indented(std::ostream& s, const std::string& text, const char * dx);
+extern std::string get_type(oks::OksData::Type oks_type, bool is_cpp);
+extern std::string get_full_cpp_class_name(const oks::OksClass * c, const ClassInfo::Map& cl_info, const std::string & cpp_ns_name);
+extern std::string get_include_dir(const oks::OksClass * c, const ClassInfo::Map& cl_info, const std::string& cpp_hdr_dir);
+extern std::string int2dx(int level);
+extern int open_cpp_namespace(std::ostream& s, const std::string& value);
+extern void close_cpp_namespace(std::ostream& s, int level);
+extern std::string get_method_header_prologue(oks::OksMethodImplementation *);
+extern std::string get_method_header_epilogue(oks::OksMethodImplementation *);
+extern std::string get_public_section(oks::OksMethodImplementation * mi);
+extern std::string get_private_section(oks::OksMethodImplementation * mi);
+extern std::string get_member_initializer_list(oks::OksMethodImplementation * mi);
+extern std::string get_method_implementation_body(oks::OksMethodImplementation * mi);
+extern bool get_add_algo_1(oks::OksMethodImplementation * mi);
+extern bool get_add_algo_n(oks::OksMethodImplementation * mi);
+extern oks::OksMethodImplementation * find_cpp_method_implementation(const oks::OksMethod * method);
+
+
+  /**
+   *  The function has_superclass returns true if 'tested' class
+   *  has class 'c' as a superclass
+   */
+
+static bool
+has_superclass(const oks::OksClass * tested, const oks::OksClass * c)
+{
+  if (const oks::OksClass::FList * sclasses = tested->all_super_classes())
+    {
+      for (const auto& i : *sclasses)
+        {
+          if (i == c)
+            {
+              return true;
+            }
+        }
+    }
+
+  return false;
+}
+
+  /**
+   *  The function add_ordered_super_classes() appends all superclasses of the class
+   *  in the order their data are visited (superclasses first); a superclass reachable
+   *  by several inheritance paths is appended once
+   */
+
+static void
+add_ordered_super_classes(const oks::OksClass * cl, std::vector<const oks::OksClass *>& classes)
+{
+  if (const std::list<std::string*> * slist = cl->direct_super_classes())
+    for (const auto& i : *slist)
+      if (const oks::OksClass * c = cl->get_kernel()->find_class(*i))
+        if (std::find(classes.begin(), classes.end(), c) == classes.end())
+          {
+            add_ordered_super_classes(c, classes);
+            classes.push_back(c);
+          }
+}
+
+  /**
+   *  The function get_inheritance_paths() returns number of inheritance paths from
+   *  the class to its superclass 'c' and puts classes of the first one into 'first_path'
+   */
+
+static unsigned int
+get_inheritance_paths(const oks::OksClass * cl, const oks::OksClass * c, std::vector<const oks::OksClass *>& path, std::vector<const oks::OksClass *>& first_path)
+{
+  unsigned int count = 0;
+
+  if (const std::list<std::string*> * slist = cl->direct_super_classes())
+    for (const auto& i : *slist)
+      if (const oks::OksClass * s = cl->get_kernel()->find_class(*i))
+        {
+          path.push_back(s);
+
+          if (s == c)
+            {
+              if (first_path.empty())
+                first_path = path;
+
+              count++;
+            }
+          else
+            {
+              count += get_inheritance_paths(s, c, path, first_path);
+            }
+
+          path.pop_back();
+        }
+
+  return count;
+}
+
+  /**
+   *  The function get_super_class_object() returns expression converting *this to
+   *  object of superclass 'c'; the generated classes do not use virtual inheritance,
+   *  so a superclass inherited by several paths is converted via the first of them
+   */
+
+static std::string
+get_super_class_object(const oks::OksClass * cl, const oks::OksClass * c, bool is_const, const std::string& cpp_ns_name, const ClassInfo::Map& cl_info)
+{
+  std::vector<const oks::OksClass *> path, first_path;
+  std::string s("*this");
+
+  if (get_inheritance_paths(cl, c, path, first_path) > 1)
+    for (std::size_t i = 0; i + 1 < first_path.size(); ++i)
+      s = std::string("static_cast<") + (is_const ? "const " : "") + get_full_cpp_class_name(first_path[i], cl_info, cpp_ns_name) + "&>(" + s + ')';
+
+  return s;
+}
+
+  /**
+   *  The function has_lazy_relationships returns true if direct
+   *  relationships of the class are resolved on first access
+   */
+
+static bool
+has_lazy_relationships(const oks::OksClass * c, const GenerationOptions& options)
+{
+  return (options.m_lazy_relationships && c->direct_relationships() && !c->direct_relationships()->empty());
+}
+
+  /**
+   *  The function has_lazy_attributes returns true if direct
+   *  attributes of the class are decoded on first access
+   */
+
+static bool
+has_lazy_attributes(const oks::OksClass * c, const GenerationOptions& options)
+{
+  return (options.m_lazy_attributes.find(c->get_name()) != options.m_lazy_attributes.end() && c->direct_attributes() && !c->direct_attributes()->empty());
+}
+
+  /**
+   *  The function is_typed_enum returns true if the attribute is
+   *  single-value enumeration, whose value is stored as enum class
+   */
+
+static bool
+is_typed_enum(const oks::OksAttribute * a, const GenerationOptions& options)
+{
+  return (options.m_typed_enums && a->get_data_type() == oks::OksData::enum_type && !a->get_is_multi_values() && !a->get_range().empty());
+}
+
+
+  /**
+   *  The function get_chrono_type returns the std::chrono type used to store
+   *  value of date or time attribute, or nullptr if its string is stored
+   */
+
+static const char *
+get_chrono_type(const oks::OksAttribute * a, const GenerationOptions& options)
+{
+  if (options.m_chrono_dates)
+    {
+      if (a->get_data_type() == oks::OksData::date_type)
+        return "std::chrono::sys_days";
+      else if (a->get_data_type() == oks::OksData::time_type)
+        return "std::chrono::sys_seconds";
+    }
+
+  return nullptr;
+}
+
+static bool
+has_chrono_attributes(const oks::OksClass * c, const GenerationOptions& options)
+{
+  if (const std::list<oks::OksAttribute*> * alist = c->direct_attributes())
+    for (const auto& i : *alist)
+      if (get_chrono_type(i, options))
+        return true;
+
+  return false;
+}
+
+
+  /**
+   *  The function is_bit_member returns true if the attribute
+   *  is packed into bitfield
+   */
+
+static bool
+is_bit_member(const oks::OksAttribute * a, const GenerationOptions& options)
+{
+  return (options.m_compact_layout && a->get_data_type() == oks::OksData::bool_type && !a->get_is_multi_values());
+}
+
+
+  /**
+   *  The function has_direct_data() returns true if the class has direct
+   *  attributes or relationships
+   */
+
+static bool
+has_direct_data(const oks::OksClass * cl)
+{
+  return ((cl->direct_attributes() && !cl->direct_attributes()->empty()) || (cl->direct_relationships() && !cl->direct_relationships()->empty()));
+}
+
+
+  /**
+   *  The function add_snapshot_signature() describes the data written into
+   *  snapshot by the class (data of superclasses first, then attributes and
+   *  relationships); the hash of the description detects obsolete snapshots
+   */
+
+static void
+add_snapshot_signature(const oks::OksClass * cl, const GenerationOptions& options, std::string& s)
+{
+  if (const std::list<std::string*> * slist = cl->direct_super_classes())
+    for (const auto& i : *slist)
+      if (const oks::OksClass * c = cl->get_kernel()->find_class(*i))
+        add_snapshot_signature(c, options, s);
+
+  s += cl->get_name() + ':';
+
+  if (const std::list<oks::OksAttribute*> * alist = cl->direct_attributes())
+    for (const auto& i : *alist)
+      s += i->get_name() + ' ' + i->get_type() + (i->get_is_multi_values() ? "[] " : " ") + i->get_range() + (get_chrono_type(i, options) ? " chrono;" : ";");
+
+  if (const std::list<oks::OksRelationship*> * rlist = cl->direct_relationships())
+    for (const auto& i : *rlist)
+      s += i->get_name() + ' ' + i->get_type() + (i->get_high_cardinality_constraint() == oks::OksRelationship::Many ? "[];" : ";");
+
+  s += '\n';
+}
+
+static uint64_t
+get_snapshot_signature(const oks::OksClass * cl, const GenerationOptions& options)
+{
+  std::string s;
+  add_snapshot_signature(cl, options, s);
+
+  // 64-bits FNV-1a hash
+
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (unsigned char c : s)
+    {
+      hash ^= c;
+      hash *= 0x100000001b3ULL;
+    }
+
+  return hash;
+}
+
+
+  /**
+   *  The function gen_attribute_read() generates code reading value of attribute
+   *  from config object into its member; the source is the beginning of the call
+   *  expression reading a value, which is completed by the name of the variable.
+   */
+
+static void
+gen_attribute_read(std::ostream& cpp_s, const std::string& dx, const oks::OksAttribute * i, const std::string& source, const GenerationOptions& options)
+{
+  const std::string cpp_name = alnum_name(i->get_name());
+
+  auto read = [&source](const std::string& value) -> std::string { return source + value + ')'; };
+
+  if (is_typed_enum(i, options))
+    {
+      const std::string enum_name(capitalize_name(cpp_name));
+
+      cpp_s
+        << dx << "{\n"
+        << dx << "  std::string value;\n"
+        << dx << "  " << read("value") << ";\n"
+        << dx << "  if (!" << enum_name << "::from_string(value, m_" << cpp_name << "))\n"
+        << dx << "    throw dunedaq::conffwk::Generic(ERS_HERE, (std::string(\"unexpected value \\\"\") + value + \"\\\" of enumeration attribute \\\"\" + s_" << cpp_name << " + '\\\"').c_str());\n"
+        << dx << "}\n";
+    }
+  else if (get_chrono_type(i, options))
+    {
+      const bool is_date(i->get_data_type() == oks::OksData::date_type);
+      const std::string error(std::string("throw dunedaq::conffwk::Generic(ERS_HERE, (std::string(\"cannot parse ") + (is_date ? "date" : "time") + " \\\"\") + x + \"\\\" of attribute \\\"\" + s_" + cpp_name + " + '\\\"').c_str());\n");
+
+      cpp_s << dx << "{\n";
+
+      if (i->get_is_multi_values())
+        cpp_s
+          << dx << "  std::vector<std::string> values;\n"
+          << dx << "  " << read("values") << ";\n"
+          << dx << "  m_" << cpp_name << ".clear();\n"
+          << dx << "  m_" << cpp_name << ".reserve(values.size());\n"
+          << dx << "  for (const auto& x : values)\n"
+          << dx << "    {\n"
+          << dx << "      std::chrono::sys_seconds value;\n"
+          << dx << "      if (!__str2time(x, value))\n"
+          << dx << "        " << error
+          << dx << "      m_" << cpp_name << ".push_back(" << (is_date ? "std::chrono::floor<std::chrono::days>(value)" : "value") << ");\n"
+          << dx << "    }\n";
+      else
+        cpp_s
+          << dx << "  std::string x;\n"
+          << dx << "  std::chrono::sys_seconds value;\n"
+          << dx << "  " << read("x") << ";\n"
+          << dx << "  if (!__str2time(x, value))\n"
+          << dx << "    " << error
+          << dx << "  m_" << cpp_name << " = " << (is_date ? std::string("std::chrono::floor<std::chrono::days>(value)") : std::string("value")) << ";\n";
+
+      cpp_s << dx << "}\n";
+    }
+  else if (is_bit_member(i, options))
+    {
+      cpp_s
+        << dx << "{\n"
+        << dx << "  bool value;\n"
+        << dx << "  " << read("value") << ";\n"
+        << dx << "  m_" << cpp_name << " = value;\n"
+        << dx << "}\n";
+    }
+  else
+    {
+      cpp_s << dx << read("m_" + cpp_name) << ";\n";
+    }
+}
+
+
+  /**
+   *  The function gen_getter_prologue() generates locking and checks
+   *  of the object made by getters before returning a value
+   */
+
+static void
+gen_getter_prologue(std::ostream& s, const std::string& dx)
+{
+  s
+    << dx << "std::lock_guard scoped_lock(m_mutex);\n"
+    << dx << "check();\n"
+    << dx << "check_init();\n";
+}
+
+  /**
+   *  The function gen_attribute_getter_prologue() generates prologue of attribute
+   *  getter; the attributes decoded on first access are decoded under the lock
+   */
+
+static void
+gen_attribute_getter_prologue(std::ostream& s, const std::string& dx, const std::string& aname, bool lazy)
+{
+  gen_getter_prologue(s, dx);
+
+  if (lazy)
+    s << dx << "__decode_" << aname << "();\n";
+}
+
+  /**
+   *  The function is_member_referenced() returns true if the code contains
+   *  identifier m_<name> of data member
+   */
+
+static bool
+is_member_referenced(const std::string& code, const std::string& name)
+{
+  const std::string member(std::string("m_") + alnum_name(name));
+
+  for (std::string::size_type idx = code.find(member); idx != std::string::npos; idx = code.find(member, idx + 1))
+    {
+      const std::string::size_type end = idx + member.size();
+
+      if ((idx == 0 || !(isalnum(code[idx - 1]) || code[idx - 1] == '_')) && (end == code.size() || !(isalnum(code[end]) || code[end] == '_')))
+        return true;
+    }
+
+  return false;
+}
+
+
+  /**
+   *  The function gen_method_prologue() generates prologue of user-defined method;
+   *  the method body may read data members of the class directly, so members read
+   *  on first access and referenced by the body are read before it under the lock
+   */
+
+static void
+gen_method_prologue(std::ostream& s, const oks::OksClass * cl, const std::string& body, const std::string& dx, const GenerationOptions& options)
+{
+  std::vector<const oks::OksAttribute *> attributes;
+  std::vector<const oks::OksRelationship *> relationships;
+
+  if (has_lazy_attributes(cl, options))
+    for (const auto& i : *cl->direct_attributes())
+      if (is_member_referenced(body, i->get_name()))
+        attributes.push_back(i);
+
+  if (has_lazy_relationships(cl, options))
+    for (const auto& i : *cl->direct_relationships())
+      if (is_member_referenced(body, i->get_name()))
+        relationships.push_back(i);
+
+  if (!attributes.empty() || !relationships.empty())
+    {
+      s << dx << "  {\n";
+
+      gen_getter_prologue(s, dx + "    ");
+
+      for (const auto& i : attributes)
+        s << dx << "    __decode_" << alnum_name(i->get_name()) << "();\n";
+
+      for (const auto& i : relationships)
+        s << dx << "    __resolve_" << alnum_name(i->get_name()) << "();\n";
+
+      s << dx << "  }\n\n";
+    }
+}
+
+const std::string WHITESPACE = " \n\r\t\f\v";
+ 
+std::string ltrim(const std::string &s)
+{
+    size_t start = s.find_first_not_of(WHITESPACE);
+    return (start == std::string::npos) ? "" : s.substr(start);
+}
+ 
+std::string rtrim(const std::string &s)
+{
+    size_t end = s.find_last_not_of(WHITESPACE);
+    return (end == std::string::npos) ? "" : s.substr(0, end + 1);
+}
+ 
+std::string trim(const std::string &s) {
+    return rtrim(ltrim(s));
+}
+
+const std::vector<std::string> cpp_method_virtual_specifiers = {
+    "virtual",
+    "override",
+    "final"
+};
+
+  /**
+   *  The function build_class_names_index() puts all classes of the kernel into the index
+   */
+
+void
+build_class_names_index(const oks::OksKernel& kernel, ClassNamesIndex& index)
+{
+  index.reserve(kernel.classes().size());
+
+  for (const auto &j : kernel.classes())
+    index.emplace(j.second->get_name(), j.second);
+}
+
+
+  /**
+   *  The function add_method_classes() adds to the set classes
+   *  used by prototypes of c++ methods of given class.
+   *
+   *  A class is used, if the first occurrence of its name in the prototype is
+   *  not surrounded by alphanumeric symbols. To avoid search of every class name,
+   *  the prototype is split into identifiers; the candidates are identifiers and
+   *  their parts separated by underscores, which are looked up in the index.
+   */
+
+void
+add_method_classes(const oks::OksClass *cl, const ClassNamesIndex& names, std::set<oks::OksClass*>& rclasses)
+{
+  if (const std::list<oks::OksMethod*> *mlist = cl->direct_methods())
+    {
+      for (const auto &i : *mlist)
+        {
+          if (oks::OksMethodImplementation *mi = find_cpp_method_implementation(i))
+            {
+              const std::string mp(mi->get_prototype());
+              const std::string::size_type len = mp.size();
+
+              for (std::string::size_type begin = 0; begin < len;)
+                {
+                  if (!isalnum(mp[begin]) && mp[begin] != '_')
+                    {
+                      begin++;
+                      continue;
+                    }
+
+                  std::string::size_type end = begin;
+                  while (end < len && (isalnum(mp[end]) || mp[end] == '_'))
+                    end++;
+
+                  for (std::string::size_type b = begin; b < end; ++b)
+                    {
+                      if (b != begin && mp[b - 1] != '_')
+                        continue;
+
+                      for (std::string::size_type e = b + 1; e <= end; ++e)
+                        {
+                          if (e != end && mp[e] != '_')
+                            continue;
+
+                          ClassNamesIndex::const_iterator x = names.find(mp.substr(b, e - b));
+                          if (x != names.end())
+                            {
+                              const std::string& s(x->first);
+                              std::string::size_type idx = mp.find(s);
+                              if ((idx == 0 || !isalnum(mp[idx - 1])) && !isalnum(mp[idx + s.size()]))
+                                rclasses.insert(x->second);
+                            }
+                        }
+                    }
+
+                  begin = end;
+                }
+            }
+        }
+    }
+}
+
+  /**
+   *  The function get_data_members() returns data members of the generated class
+   *  in the order of their declaration: in the order of schema attributes and
+   *  relationships, or by decreasing alignment with bitfields at the end in case
+   *  of compact layout.
+   */
+
+void
+get_data_members(const oks::OksClass *cl, const std::string& cpp_ns_name, const ClassInfo::Map& cl_info, const GenerationOptions& options, std::vector<DataMember>& members)
+{
+  members.clear();
+
+  const bool lazy_attributes(has_lazy_attributes(cl, options));
+
+  if (const std::list<oks::OksAttribute*> * alist = cl->direct_attributes())
+    {
+      for (const auto& i : *alist)
+        {
+          const char * chrono_type = get_chrono_type(i, options);
+          const std::string cpp_type = (chrono_type ? chrono_type : get_type(i->get_data_type(), true));
+          DataMember m { cpp_type, alnum_name(i->get_name()), 8, 8, false };
+
+          if (i->get_is_multi_values())
+            {
+              m.m_type = std::string("std::vector<") + cpp_type + '>';
+              m.m_size = 24;
+            }
+          else if (is_typed_enum(i, options))
+            {
+              m.m_type = capitalize_name(m.m_name) + "::Enum";
+              m.m_size = m.m_alignment = 1;
+
+              oks::Oks::Tokenizer t(i->get_range(), ",");
+              unsigned int count = 0;
+              while (!t.next().empty())
+                count++;
+
+              if (count > 256)
+                m.m_size = m.m_alignment = 2;
+            }
+          else if (chrono_type)
+            {
+              if (i->get_data_type() == oks::OksData::date_type)
+                m.m_size = m.m_alignment = 4;
+            }
+          else
+            {
+              switch (i->get_data_type())
+                {
+                  case oks::OksData::bool_type:
+                  case oks::OksData::s8_int_type:
+                  case oks::OksData::u8_int_type:
+                    m.m_size = m.m_alignment = 1;
+                    m.m_is_bit = is_bit_member(i, options);
+                    break;
+
+                  case oks::OksData::s16_int_type:
+                  case oks::OksData::u16_int_type:
+                    m.m_size = m.m_alignment = 2;
+                    break;
+
+                  case oks::OksData::s32_int_type:
+                  case oks::OksData::u32_int_type:
+                  case oks::OksData::float_type:
+                    m.m_size = m.m_alignment = 4;
+                    break;
+
+                  case oks::OksData::string_type:
+                  case oks::OksData::enum_type:
+                  case oks::OksData::date_type:
+                  case oks::OksData::time_type:
+                  case oks::OksData::class_type:
+                    m.m_size = 32;
+                    break;
+
+                  default:
+                    break;
+                }
+            }
+
+          if (lazy_attributes)
+            m.m_type = "mutable " + m.m_type;
+
+          members.push_back(m);
+        }
+    }
+
+  if (const std::list<oks::OksRelationship*> *rlist = cl->direct_relationships())
+    {
+      for (const auto& i : *rlist)
+        {
+          const std::string full_class_name(get_full_cpp_class_name(i->get_class_type(), cl_info, cpp_ns_name));
+
+          const std::string qualifier(options.m_lazy_relationships ? "mutable " : "");
+
+          if (i->get_high_cardinality_constraint() == oks::OksRelationship::Many)
+            members.push_back(DataMember { qualifier + "std::vector<const " + full_class_name + "*>", alnum_name(i->get_name()), 24, 8, false });
+          else
+            members.push_back(DataMember { qualifier + "const " + full_class_name + '*', alnum_name(i->get_name()), 8, 8, false });
+        }
+    }
+
+  if (options.m_compact_layout)
+    std::stable_sort(members.begin(), members.end(), [](const DataMember& a, const DataMember& b)
+      { return (a.m_is_bit != b.m_is_bit ? b.m_is_bit : a.m_alignment > b.m_alignment); });
+}
+
+
+  /**
+   *  The function gen_template_instantiations() generates explicit instantiations
+   *  of conffwk templates used for given class. The header declares them as
+   *  extern (prefix "extern template"), so they are compiled once by the class
+   *  implementation file (prefix "template") instead of every user of the class.
+   */
+
+static void
+gen_template_instantiations(std::ostream& s, const std::string& name, const char * prefix)
+{
+  s <<
+    "  // explicit instantiation of conffwk templates for class " << name << "\n\n"
+    << prefix << " class dunedaq::conffwk::Configuration::Cache<" << name << ">;\n"
+    << prefix << " const " << name << " * dunedaq::conffwk::Configuration::get<" << name << ">(dunedaq::conffwk::ConfigObject&, bool, bool);\n"
+    << prefix << " const " << name << " * dunedaq::conffwk::Configuration::get<" << name << ">(const std::string&, bool, bool, unsigned long, const std::vector<std::string> *);\n"
+    << prefix << " void dunedaq::conffwk::Configuration::get<" << name << ">(std::vector<const " << name << " *>&, bool, bool, const std::string&, unsigned long, const std::vector<std::string> *);\n"
+    << prefix << " const " << name << " * dunedaq::conffwk::Configuration::_ref<" << name << ">(dunedaq::conffwk::ConfigObject&, const std::string&, bool);\n"
+    << prefix << " void dunedaq::conffwk::Configuration::_ref<" << name << ">(dunedaq::conffwk::ConfigObject&, const std::string&, std::vector<const " << name << " *>&, bool);\n\n";
+}
+
+
+void
+gen_header(const oks::OksClass *cl,
+           std::ostream& cpp_file,
+           const std::string& cpp_ns_name,
+           const std::string& cpp_hdr_dir,
+           const ClassInfo::Map& cl_info,
+           const ClassNamesIndex& cl_names,
+           const GenerationOptions& options)
+{
+  const std::string name(alnum_name(cl->get_name()));
+
+
+    // get includes for super classes if necessary
+
+  if (const std::list<std::string*> * super_list = cl->direct_super_classes())
+    {
+      cpp_file << "  // include files for classes used in inheritance hierarchy\n\n";
+
+      for (const auto& i : *super_list)
+        {
+          oks::OksClass * c = cl->get_kernel()->find_class(*i);
+          cpp_file << "#include \"" << get_include_dir(c, cl_info, cpp_hdr_dir) << ".hpp\"\n";
+        }
+    }
+
+  cpp_file << std::endl;
+
+
+    // generate forward declarations if necessary
+    {
+      // create set of classes to avoid multiple forward declarations of the same class
+      std::set<oks::OksClass*> rclasses;
+
+      // check direct relationships (c++)
+      if (cl->direct_relationships() && !cl->direct_relationships()->empty())
+        for (const auto &i : *cl->direct_relationships())
+          rclasses.insert(i->get_class_type());
+
+      // check methods
+      add_method_classes(cl, cl_names, rclasses);
+
+      NameSpaceInfo ns_info;
+      bool use_fwd_header = false;
+
+      for (const auto &c : rclasses)
+        {
+          // check if the class' header is not already included
+          if (has_superclass(cl, c) || cl == c)
+            continue;
+
+          ClassInfo::Map::const_iterator idx = cl_info.find(c);
+
+          // generated classes are declared by the forward declarations header, external ones inline
+          if (options.m_fwd_header && idx == cl_info.end())
+            {
+              use_fwd_header = true;
+              continue;
+            }
+
+          ns_info.add((idx != cl_info.end() ? (*idx).second.get_namespace() : cpp_ns_name), alnum_name(c->get_name()));
+        }
+
+      if (use_fwd_header || !ns_info.empty())
+        {
+          cpp_file << "  // forward declaration for classes used in relationships and algorithms\n\n";
+
+          if (use_fwd_header)
+            {
+              cpp_file << "#include \"";
+              if (!cpp_hdr_dir.empty())
+                cpp_file << cpp_hdr_dir << '/';
+              cpp_file << get_fwd_header_name(cpp_ns_name) << ".hpp\"\n\n";
+            }
+
+          if (!ns_info.empty())
+            ns_info.print(cpp_file, 0);
+
+          cpp_file << "\n\n";
+        }
+    }
+
+    // generate methods prologues if necessary
+
+  if (const std::list<oks::OksMethod*> *mlist = cl->direct_methods())
+    for (const auto &i : *mlist)
+      if (oks::OksMethodImplementation *mi = find_cpp_method_implementation(i))
+        if (!get_method_header_prologue(mi).empty())
+          {
+            cpp_file << "  // prologue of method " << cl->get_name() << "::" << i->get_name() << "()\n";
+            cpp_file << get_method_header_prologue(mi) << std::endl;
+          }
+
+
+    // open namespace
+
+  int ns_level = open_cpp_namespace(cpp_file, cpp_ns_name);
+  std::string ns_dx = int2dx(ns_level);
+  std::string ns_dx2 = ns_dx + "    ";
+  
+  const char * dx  = ns_dx.c_str();    // are used for alignment
+  const char * dx2 = ns_dx2.c_str();
+
+
+    // generate description
+
+  {
+    std::string txt("Declares methods to get and put values of attributes / relationships, to print and to destroy object.\n");
+
+    txt +=
+      "<p>\n"
+      "The methods can throw several exceptions:\n"
+      "<ul>\n"
+      " <li><code>conffwk.NotFoundException</code> - in case of wrong attribute or relationship name (e.g. in case of database schema modification)\n"
+      " <li><code>conffwk.SystemException</code> - in case of system problems (communication or implementation database failure, schema modification, object destruction, etc.)\n"
+      "</ul>\n"
+      "<p>\n"
+      "In addition the methods modifying database (set value, destroy object) can throw <code>conffwk.NotAllowedException</code> "
+      "exception in case, if there are no write access rights or database is already locked by other process.\n";
+
+    if (!cl->get_description().empty())
+      {
+        txt += "\n<p>\n";
+        txt += cl->get_description();
+        txt += "\n";
+      }
+ 
+    txt += "@author oksdalgen\n";
+
+    cpp_file << std::endl;
+    print_description(cpp_file, cl->get_description(), dx);
+  }
+
+    // generate class declaration itself
+
+  cpp_file << dx << "class " << name << " : ";
+
+    // generate inheritance list
+
+  if (const std::list<std::string*> * super_list = cl->direct_super_classes())
+    {
+      for (std::list<std::string*>::const_iterator i = super_list->begin(); i != super_list->end();)
+        {
+          const oks::OksClass * c = cl->get_kernel()->find_class(**i);
+          cpp_file << "public " << get_full_cpp_class_name(c, cl_info, cpp_ns_name);
+          if (++i != super_list->end())
+            cpp_file << ", ";
+        }
+    }
+  else
+    {
+      cpp_file << "public virtual dunedaq::conffwk::DalObject";
+    }
+
+  cpp_file << " {\n\n";
+
+    // generate standard methods
+
+  cpp_file
+    << dx << "  friend class conffwk::Configuration;\n"
+    << dx << "  friend class conffwk::Configuration::Cache<" << name << ">;\n\n"
+    << dx << "  friend class conffwk::DalObject;\n\n"
+    << dx << "  protected:\n\n"
+    << dx << "    " << name << "(conffwk::Configuration& db, const conffwk::ConfigObject& obj) noexcept;\n"
+    << dx << "    virtual ~" << name << "() noexcept;\n"
+    << dx << "    virtual void init(bool init_children);\n\n"
+    << dx << "  public:\n\n"
+    << dx << "      /** The name of the conffwkuration class. */\n\n"
+    << dx << "    static const std::string& s_class_name;\n\n\n"
+    << dx << "      /**\n"
+    << dx << "       * \\brief Print details of the " << name << " object.\n"
+    << dx << "       *\n"
+    << dx << "       * Parameters are:\n"
+    << dx << "       *   \\param offset        number of spaces to shift object right (useful to print nested objects)\n"
+    << dx << "       *   \\param print_header  if false, do not print object header (to print attributes of base classes)\n"
+    << dx << "       *   \\param s             output stream\n"
+    << dx << "       */\n\n"
+    << dx << "    virtual void print(unsigned int offset, bool print_header, std::ostream& s) const;\n\n\n"
+    << dx << "      /**\n"
+    << dx << "       * \\brief Get values of relationships and results of some algorithms as a vector of dunedaq::conffwk::DalObject pointers.\n"
+    << dx << "       *\n"
+    << dx << "       * Parameters are:\n"
+    << dx << "       *   \\param name          name of the relationship or algorithm\n"
+    << dx << "       *   \\return              value of relationship or result of algorithm\n"
+    << dx << "       *   \\throw               std::exception if there is no relationship or algorithm with such name in this and base classes\n"
+    << dx << "       */\n\n"
+    << dx << "    virtual std::vector<const dunedaq::conffwk::DalObject *> get(const std::string& name, bool upcast_unregistered = true) const;\n\n"
+    << dx << "    std::vector<const dunedaq::conffwk::DalObject *> get(std::string_view name, bool upcast_unregistered = true) const;\n\n"
+    << dx << "    std::vector<const dunedaq::conffwk::DalObject *> get(const char * name, bool upcast_unregistered = true) const { return get(std::string_view(name), upcast_unregistered); }\n\n\n"
+    << dx << "  protected:\n\n"
+    << dx << "    bool get(const std::string& name, std::vector<const dunedaq::conffwk::DalObject *>& vec, bool upcast_unregistered, bool first_call) const;\n\n"
+    << dx << "    bool get(std::string_view name, std::vector<const dunedaq::conffwk::DalObject *>& vec, bool upcast_unregistered, bool first_call) const;\n\n"
+    << dx << "    bool __get(std::string_view name, const std::string * str, std::vector<const dunedaq::conffwk::DalObject *>& vec, bool upcast_unregistered, bool first_call) const;\n\n\n";
+
+
+    // generate class attributes and relationships in accordance with
+    // database schema
+
+    // generate enumerations before members of their types
+
+  if (const std::list<oks::OksAttribute*> * alist = (options.m_typed_enums ? cl->direct_attributes() : nullptr))
+    {
+      bool is_first = true;
+
+      for (const auto& i : *alist)
+        {
+          if (i->get_data_type() == oks::OksData::enum_type && !i->get_range().empty())
+            {
+              const std::string aname(alnum_name(i->get_name()));
+
+              if (is_first)
+                {
+                  cpp_file << dx << "  public:\n\n";
+                  is_first = false;
+                }
+
+              std::string description("Valid enumeration values to compare with value returned by get_");
+              description += aname;
+              description += "() and to pass value to set_";
+              description += aname;
+              description += "() methods.\n"
+                             "The Enum type and the to_string() / from_string() methods convert them to strongly typed values.";
+
+              print_description(cpp_file, description, dx2);
+
+              cpp_file << dx << "    struct " << capitalize_name(aname) << " {\n";
+
+              // names of tokens colliding with the Enum type or with names of previous tokens get '_' suffix
+
+              std::vector<std::string> tokens, names;
+              std::set<std::string> used_names{"Enum"};
+
+              oks::Oks::Tokenizer t(i->get_range(), ",");
+              std::string token;
+              while (!(token = t.next()).empty())
+                {
+                  std::string name(capitalize_name(alnum_name(token)));
+
+                  while (!used_names.insert(name).second)
+                    name.push_back('_');
+
+                  cpp_file << dx << "      inline static const std::string " << name << " = \"" << token << "\";\n";
+                  tokens.push_back(token);
+                  names.push_back(name);
+                }
+
+              cpp_file << '\n' << dx << "      enum class Enum : " << (tokens.size() > 256 ? "uint16_t" : "uint8_t") << " {";
+
+              for (std::size_t j = 0; j < names.size(); ++j)
+                cpp_file << (j ? ", " : " ") << names[j];
+
+              cpp_file << " };\n\n" << dx << "      static constexpr std::string_view s_values[] = {";
+
+              for (std::size_t j = 0; j < tokens.size(); ++j)
+                cpp_file << (j ? ", " : " ") << '\"' << tokens[j] << '\"';
+
+              cpp_file
+                << " };\n\n"
+                << dx << "      static constexpr std::string_view\n"
+                << dx << "      to_string(Enum value) noexcept\n"
+                << dx << "        {\n"
+                << dx << "          return s_values[static_cast<std::size_t>(value)];\n"
+                << dx << "        }\n\n"
+                << dx << "      static constexpr bool\n"
+                << dx << "      from_string(std::string_view str, Enum& value) noexcept\n"
+                << dx << "        {\n"
+                << dx << "          for (std::size_t i = 0; i < std::size(s_values); ++i)\n"
+                << dx << "            if (s_values[i] == str)\n"
+                << dx << "              {\n"
+                << dx << "                value = static_cast<Enum>(i);\n"
+                << dx << "                return true;\n"
+                << dx << "              }\n\n"
+                << dx << "          return false;\n"
+                << dx << "        }\n\n"
+                << dx << "      static const std::string&\n"
+                << dx << "      to_std_string(Enum value) noexcept\n"
+                << dx << "        {\n"
+                << dx << "          switch (value)\n"
+                << dx << "            {\n";
+
+              for (const auto& x : names)
+                cpp_file << dx << "              case Enum::" << x << ": return " << x << ";\n";
+
+              cpp_file
+                << dx << "            }\n\n"
+                << dx << "          return " << names.front() << ";\n"
+                << dx << "        }\n"
+                << dx << "    };\n\n";
+            }
+        }
+
+      if (!is_first)
+        cpp_file << std::endl;
+    }
+
+
+  if (cl->direct_attributes() || cl->direct_relationships() || cl->direct_methods())
+    {
+      cpp_file << dx << "  private:\n\n";
+
+      // generate attributes and relationships:
+      //  - for single attributes this is a normal member variable.
+      //  - for multiple values this is a std::vector<T>.
+      //  - for single value relationship this is just a pointer.
+      //  - for multiple values relationship this is a vector of pointers.
+
+        {
+          std::vector<DataMember> members;
+
+          get_data_members(cl, cpp_ns_name, cl_info, options, members);
+
+          for (const auto& i : members)
+            cpp_file << dx << "    " << i.m_type << " m_" << i.m_name << (i.m_is_bit ? " : 1" : "") << ";\n";
+        }
+
+
+      // generate state of attributes decoded on first access
+
+      if (has_lazy_attributes(cl, options))
+        {
+          cpp_file
+            << "\n"
+            << dx << "      // bit is set when the attribute is decoded; all bits are reset by init()\n\n"
+            << dx << "    mutable std::bitset<" << cl->direct_attributes()->size() << "> m_decoded_attributes;\n\n";
+
+          for (const auto& i : *cl->direct_attributes())
+            cpp_file << dx << "    void __decode_" << alnum_name(i->get_name()) << "() const;\n";
+        }
+
+
+      // generate state of relationships resolved on first access
+
+      if (has_lazy_relationships(cl, options))
+        {
+          cpp_file
+            << "\n"
+            << dx << "      // bit is set when the relationship is resolved; all bits are reset by init()\n\n"
+            << dx << "    mutable std::bitset<" << cl->direct_relationships()->size() << "> m_resolved_relationships;\n\n";
+
+          for (const auto& i : *cl->direct_relationships())
+            cpp_file << dx << "    void __resolve_" << alnum_name(i->get_name()) << "() const;\n";
+        }
+
+
+      // generate conversions of date and time attributes
+
+      if (has_chrono_attributes(cl, options))
+        {
+          cpp_file
+            << "\n"
+            << dx << "      // conversions of date and time attributes from and to strings used by the database\n\n"
+            << dx << "    static bool __str2time(const std::string& str, std::chrono::sys_seconds& value) noexcept;\n"
+            << dx << "    static std::string __date2str(std::chrono::sys_days value);\n"
+            << dx << "    static std::string __time2str(std::chrono::sys_seconds value);\n";
+        }
+
+
+      // generate methods extension if any
+
+      if (const std::list<oks::OksMethod*> * mlist = cl->direct_methods())
+        {
+          for (const auto& i : *mlist)
+            {
+              if (oks::OksMethodImplementation * mi = find_cpp_method_implementation(i))
+                {
+                  std::string method_extension = get_private_section(mi);
+                  if (!method_extension.empty())
+                    {
+                      cpp_file << "\n" << dx << "      // extension of method " << cl->get_name() << "::" << i->get_name() << "()\n";
+                      print_indented(cpp_file, method_extension, dx2);
+                    }
+                }
+            }
+        }
+
+
+      cpp_file << std::endl << std::endl << dx << "  public:\n\n";
+
+
+      // generate attribute accessors:
+      //  1. for each attribute generate static std::string with it's name
+      //  2a. for single values this is just:
+      //     - attribute_type attribute_name() const { return m_attribute; }
+      //  2b. for multiple values this is:
+      //     - const std::vector<attribute_type>& attribute_name() const { return m_attribute; }
+
+      if (const std::list<oks::OksAttribute*> *alist = cl->direct_attributes())
+        {
+
+          cpp_file << dx << "      // attribute names\n\n";
+
+          for (const auto& i : *alist)
+            {
+              const std::string& aname(i->get_name());
+              cpp_file << dx << "    inline static const std::string s_" << alnum_name(aname) << " = \"" << aname << "\";\n";
+            }
+
+          cpp_file << "\n";
+
+          for (const auto& i : *alist)
+            {
+              const std::string& cpp_aname(alnum_name(i->get_name()));
+              cpp_file << dx << "    static const std::string& __get_" << cpp_aname << "_str() noexcept { return s_" << cpp_aname << "; }\n";
+            }
+
+          cpp_file << std::endl << std::endl;
+
+          const bool lazy_attributes(has_lazy_attributes(cl, options));
+
+          for (const auto& i : *alist)
+            {
+              const std::string aname(alnum_name(i->get_name()));
+
+              // generate enum values
+
+              if (!options.m_typed_enums && i->get_data_type() == oks::OksData::enum_type && !i->get_range().empty())
+                {
+                  std::string description("Valid enumeration values to compare with value returned by get_");
+                  description += aname;
+                  description += "() and to pass value to set_";
+                  description += aname;
+                  description += "() methods.";
+
+                  print_description(cpp_file, description, dx2);
+
+                  description += "\nUse toString() method to compare and to pass the values. Do not use name() method.";
+
+                  cpp_file << dx << "    struct " << capitalize_name(aname) << " {\n";
+
+                  oks::Oks::Tokenizer t(i->get_range(), ",");
+                  std::string token;
+                  while (!(token = t.next()).empty())
+                    {
+                      cpp_file << dx << "      inline static const std::string " << capitalize_name(alnum_name(token)) << " = \"" << token << "\";\n";
+                    }
+
+                  cpp_file << dx << "    };\n\n";
+                }
+
+              // generate get method description
+
+                {
+
+                  std::string description("Get \"");
+                  description += i->get_name();
+                  description += "\" attribute value.\n\n";
+                  description += i->get_description();
+
+                  std::string description2("\\brief ");
+                  description2 += description;
+                  description2 += "\n\\return the attribute value\n";
+                  description2 += "\\throw dunedaq::conffwk::Generic, dunedaq::conffwk::DeletedObject\n";
+
+                  print_description(cpp_file, description2, dx2);
+                }
+
+              // generate method body
+
+              cpp_file << dx << "    ";
+
+              const char * chrono_type = get_chrono_type(i, options);
+              std::string cpp_type = (chrono_type ? chrono_type : get_type(i->get_data_type(), true));
+
+              if (i->get_is_multi_values())
+                {
+                  cpp_file << "const std::vector<" << cpp_type << ">&";
+                }
+              else
+                {
+                  if (cpp_type == "std::string")
+                    cpp_file << "const std::string&";
+                  else
+                    cpp_file << cpp_type;
+                }
+
+              cpp_file << '\n'
+                  << dx << "    get_" << aname << "() const\n"
+                  << dx << "      {\n";
+
+              gen_attribute_getter_prologue(cpp_file, ns_dx + "        ", aname, lazy_attributes);
+
+              if (is_typed_enum(i, options))
+                cpp_file << dx << "        return " << capitalize_name(aname) << "::to_std_string(m_" << aname << ");\n";
+              else
+                cpp_file << dx << "        return m_" << aname << ";\n";
+
+              cpp_file << dx << "      }\n\n";
+
+              // generate typed get method of enumeration
+
+              if (is_typed_enum(i, options))
+                {
+                  std::string description("\\brief Get \"");
+                  description += i->get_name();
+                  description += "\" attribute value as enumeration.\n";
+                  description += "\\return the attribute value\n";
+                  description += "\\throw dunedaq::conffwk::Generic, dunedaq::conffwk::DeletedObject\n";
+
+                  print_description(cpp_file, description, dx2);
+
+                  cpp_file
+                      << dx << "    " << capitalize_name(aname) << "::Enum\n"
+                      << dx << "    get_" << aname << "_enum() const\n"
+                      << dx << "      {\n";
+
+                  gen_attribute_getter_prologue(cpp_file, ns_dx + "        ", aname, lazy_attributes);
+
+                  cpp_file
+                      << dx << "        return m_" << aname << ";\n"
+                      << dx << "      }\n\n";
+                }
+
+              // generate set method description
+
+                {
+                  std::string description("Set \"");
+                  description += i->get_name();
+                  description += "\" attribute value.\n\n";
+                  description += i->get_description();
+
+                  std::string description2("\\brief ");
+                  description2 += description;
+                  description2 += "\n\\param value  new attribute value\n";
+                  description2 += "\\throw dunedaq::conffwk::Generic, dunedaq::conffwk::DeletedObject\n";
+
+                  print_description(cpp_file, description2, dx2);
+                }
+
+              // generate set method
+
+              cpp_file << dx << "    void\n" << dx << "    set_" << aname << '(';
+
+              if (i->get_is_multi_values())
+                {
+                  cpp_file << "const std::vector<" << cpp_type << ">&";
+                }
+              else
+                {
+                  if (cpp_type == "std::string")
+                    {
+                      cpp_file << "const std::string&";
+                    }
+                  else
+                    {
+                      cpp_file << cpp_type;
+                    }
+                }
+
+              cpp_file << " value)\n"
+                << dx << "      {\n"
+                << dx << "        std::lock_guard scoped_lock(m_mutex);\n"
+                << dx << "        check();\n"
+                << dx << "        clear();\n";
+
+              const char * chrono_set = (i->get_data_type() == oks::OksData::date_type ? "set_date" : "set_time");
+              const char * chrono_str = (i->get_data_type() == oks::OksData::date_type ? "__date2str" : "__time2str");
+
+              if (chrono_type && i->get_is_multi_values())
+                {
+                  cpp_file
+                    << dx << "        std::vector<std::string> values;\n"
+                    << dx << "        values.reserve(value.size());\n"
+                    << dx << "        for (const auto& x : value)\n"
+                    << dx << "          values.push_back(" << chrono_str << "(x));\n"
+                    << dx << "        p_obj." << chrono_set << "(s_" << aname << ", values);\n"
+                    << dx << "      }\n\n";
+                }
+              else if (chrono_type)
+                {
+                  cpp_file
+                    << dx << "        p_obj." << chrono_set << "(s_" << aname << ", " << chrono_str << "(value));\n"
+                    << dx << "      }\n\n";
+                }
+              else
+                {
+                  cpp_file << dx << "        p_obj.";
+
+                  if (i->get_data_type() == oks::OksData::string_type && i->get_is_multi_values() == false)
+                    {
+                      cpp_file << "set_by_ref";
+                    }
+                  else if (i->get_data_type() == oks::OksData::enum_type)
+                    {
+                      cpp_file << "set_enum";
+                    }
+                  else if (i->get_data_type() == oks::OksData::class_type)
+                    {
+                      cpp_file << "set_class";
+                    }
+                  else if (i->get_data_type() == oks::OksData::date_type)
+                    {
+                      cpp_file << "set_date";
+                    }
+                  else if (i->get_data_type() == oks::OksData::time_type)
+                    {
+                      cpp_file << "set_time";
+                    }
+                  else
+                    {
+                      cpp_file << "set_by_val";
+                    }
+
+                  cpp_file << "(s_" << aname << ", value);\n"
+                      << dx << "      }\n\n";
+                }
+
+              // generate typed set method of enumeration
+
+              if (is_typed_enum(i, options))
+                {
+                  std::string description("\\brief Set \"");
+                  description += i->get_name();
+                  description += "\" attribute value from enumeration.\n";
+                  description += "\\param value  new attribute value\n";
+                  description += "\\throw dunedaq::conffwk::Generic, dunedaq::conffwk::DeletedObject\n";
+
+                  print_description(cpp_file, description, dx2);
+
+                  cpp_file
+                    << dx << "    void\n"
+                    << dx << "    set_" << aname << '(' << capitalize_name(aname) << "::Enum value)\n"
+                    << dx << "      {\n"
+                    << dx << "        std::lock_guard scoped_lock(m_mutex);\n"
+                    << dx << "        check();\n"
+                    << dx << "        clear();\n"
+                    << dx << "        p_obj.set_enum(s_" << aname << ", " << capitalize_name(aname) << "::to_std_string(value));\n"
+                    << dx << "      }\n\n";
+                }
+
+              cpp_file << '\n';
+            }
+        }
+
+
+      // generate relationship accessors.
+      //  1. for each relationship generate static std::string with it's name
+      //  2a. for single values this is just:
+      //      - const relation_type * relation() const { return m_relation; }
+      //  2b. for multiple values this is:
+      //      - const std::vector<const relation_type*>& relation() const { return m_relation; }
+
+      if (const std::list<oks::OksRelationship*> *rlist = cl->direct_relationships())
+        {
+
+          cpp_file << dx << "      // relationship names\n\n";
+
+          for (const auto& i : *rlist)
+            {
+              const std::string& rname(i->get_name());
+              cpp_file << dx << "    inline static const std::string s_" << alnum_name(rname) << " = \"" << rname << "\";\n";
+            }
+
+          cpp_file << "\n";
+
+          for (const auto& i : *rlist)
+            {
+              const std::string& cpp_rname(alnum_name(i->get_name()));
+              cpp_file << dx << "    static const std::string& __get_" << cpp_rname << "_str() noexcept { return s_" << cpp_rname << "; }\n";
+            }
+
+          cpp_file << std::endl << std::endl;
+
+          for (const auto& i : *rlist)
+            {
+
+              // generate description
+
+                {
+                  std::string description("Get \"");
+                  description += i->get_name();
+                  description += "\" relationship value.\n\n";
+                  description += i->get_description();
+
+                  std::string description2("\\brief ");
+                  description2 += description;
+                  description2 += "\n\\return the relationship value\n";
+                  description2 += "\\throw dunedaq::conffwk::Generic, dunedaq::conffwk::DeletedObject\n";
+
+                  print_description(cpp_file, description2, dx2);
+                }
+
+              // generate method body
+
+              cpp_file << dx << "    const ";
+
+              const std::string rname(alnum_name(i->get_name()));
+              std::string full_cpp_class_name = get_full_cpp_class_name(i->get_class_type(), cl_info, cpp_ns_name);
+
+              if (i->get_high_cardinality_constraint() == oks::OksRelationship::Many)
+                {
+                  cpp_file << "std::vector<const " << full_cpp_class_name << "*>&";
+                }
+              else
+                {
+                  cpp_file << full_cpp_class_name << " *";
+                }
+
+              cpp_file << "\n"
+                  << dx << "    get_" << rname << "() const\n"
+                  << dx << "    {\n";
+
+              gen_getter_prologue(cpp_file, ns_dx + "      ");
+
+              if (options.m_lazy_relationships)
+                cpp_file << dx << "      __resolve_" << rname << "();\n";
+
+              if (i->get_low_cardinality_constraint() == oks::OksRelationship::One)
+                {
+                  if (i->get_high_cardinality_constraint() == oks::OksRelationship::One)
+                    {
+                      cpp_file
+                          << dx << "      if (!m_" << rname << ")\n"
+                          << dx << "        {\n"
+                          << dx << "          std::ostringstream text;\n"
+                          << dx << "          text << \"relationship \\\"\" << s_" << rname << " << \"\\\" of object \" << this << \" is not set\";\n"
+                          << dx << "          throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());\n"
+                          << dx << "        }\n";
+                    }
+                  else
+                    {
+                      cpp_file
+                          << dx << "      if (m_" << rname << ".empty())\n"
+                          << dx << "        {\n"
+                          << dx << "          std::ostringstream text;\n"
+                          << dx << "          text << \"relationship \\\"\" << s_" << rname << " << \"\\\" of object \" << this << \" is empty\";\n"
+                          << dx << "          throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());\n"
+                          << dx << "        }\n";
+                    }
+                }
+
+              cpp_file
+                  << dx << "      return m_" << rname << ";\n"
+                  << dx << "    }\n\n\n";
+
+              // generate set method
+
+                {
+                  std::string description("Set \"");
+                  description += i->get_name();
+                  description += "\" relationship value.\n\n";
+                  description += i->get_description();
+
+                  std::string description2("\\brief ");
+                  description2 += description;
+                  description2 += "\n\\param value  new relationship value\n";
+                  description2 += "\\throw dunedaq::conffwk::Generic, dunedaq::conffwk::DeletedObject\n";
+
+                  print_description(cpp_file, description2, dx2);
+                }
+
+              cpp_file << dx << "    void\n" << dx << "    set_" << rname << "(const ";
+
+              if (i->get_high_cardinality_constraint() == oks::OksRelationship::Many)
+                {
+                  cpp_file << "std::vector<const " << full_cpp_class_name << "*>&";
+                }
+              else
+                {
+                  cpp_file << full_cpp_class_name << " *";
+                }
+
+              cpp_file << " value);\n\n";
+            }
+        }
+    }
+
+
+    // generate compile-time descriptors of direct attributes and relationships
+
+  if (options.m_reflection)
+    {
+      cpp_file
+        << dx << "  public:\n\n"
+        << dx << "      // compile-time descriptors of direct attributes, relationships and superclasses\n"
+        << dx << "      // (see dunedaq::oksdalgen::for_each_attribute() and for_each_relationship())\n\n"
+        << dx << "    static constexpr auto\n"
+        << dx << "    reflect_attributes() noexcept\n"
+        << dx << "      {\n"
+        << dx << "        return std::make_tuple(";
+
+      if (const std::list<oks::OksAttribute*> * alist = cl->direct_attributes())
+        for (auto i = alist->begin(); i != alist->end(); ++i)
+          cpp_file
+            << (i == alist->begin() ? "\n" : ",\n")
+            << dx << "          dunedaq::oksdalgen::make_attribute_descriptor(\"" << (*i)->get_name() << "\", \"" << (*i)->get_type() << "\", "
+            << ((*i)->get_is_multi_values() ? "true" : "false") << ", dunedaq::oksdalgen::Format::"
+            << ((*i)->get_format() == oks::OksAttribute::Hex ? "Hex" : (*i)->get_format() == oks::OksAttribute::Oct ? "Oct" : "Dec")
+            << ", &" << name << "::get_" << alnum_name((*i)->get_name()) << ')';
+
+      cpp_file
+        << ");\n"
+        << dx << "      }\n\n"
+        << dx << "    static constexpr auto\n"
+        << dx << "    reflect_relationships() noexcept\n"
+        << dx << "      {\n"
+        << dx << "        return std::make_tuple(";
+
+      if (const std::list<oks::OksRelationship*> * rlist = cl->direct_relationships())
+        for (auto i = rlist->begin(); i != rlist->end(); ++i)
+          cpp_file
+            << (i == rlist->begin() ? "\n" : ",\n")
+            << dx << "          dunedaq::oksdalgen::make_relationship_descriptor(\"" << (*i)->get_name() << "\", \"" << (*i)->get_type() << "\", "
+            << ((*i)->get_high_cardinality_constraint() == oks::OksRelationship::Many ? "true" : "false") << ", "
+            << ((*i)->get_is_composite() ? "true" : "false")
+            << ", &" << name << "::get_" << alnum_name((*i)->get_name()) << ')';
+
+      cpp_file
+        << ");\n"
+        << dx << "      }\n\n"
+        << dx << "    static constexpr auto\n"
+        << dx << "    reflect_superclasses() noexcept\n"
+        << dx << "      {\n"
+        << dx << "        return std::tuple<";
+
+      if (const std::list<std::string*> * slist = cl->direct_super_classes())
+        for (auto i = slist->begin(); i != slist->end(); ++i)
+          cpp_file << (i == slist->begin() ? "const " : ", const ") << get_full_cpp_class_name(cl->get_kernel()->find_class(**i), cl_info, cpp_ns_name) << " *";
+
+      cpp_file
+        << ">();\n"
+        << dx << "      }\n\n"
+        << dx << "    static constexpr auto\n"
+        << dx << "    reflect_all_superclasses() noexcept\n"
+        << dx << "      {\n"
+        << dx << "        return std::tuple<";
+
+      std::vector<const oks::OksClass *> all_super_classes;
+      add_ordered_super_classes(cl, all_super_classes);
+
+      for (auto i = all_super_classes.begin(); i != all_super_classes.end(); ++i)
+        cpp_file << (i == all_super_classes.begin() ? "const " : ", const ") << get_full_cpp_class_name(*i, cl_info, cpp_ns_name) << " *";
+
+      cpp_file
+        << ">();\n"
+        << dx << "      }\n\n";
+    }
+
+
+    // generate binary snapshot methods
+
+  if (options.m_snapshot)
+    {
+      cpp_file
+        << dx << "  public:\n\n"
+        << dx << "      // binary snapshot of object (see dunedaq::oksdalgen::SnapshotWriter and SnapshotReader)\n\n"
+        << dx << "    inline static constexpr uint64_t __snapshot_signature = 0x" << std::hex << get_snapshot_signature(cl, options) << std::dec << "ULL;\n\n"
+        << dx << "    void write_snapshot(dunedaq::oksdalgen::SnapshotWriter& out) const;\n\n"
+        << dx << "    static const dunedaq::conffwk::DalObject * __snapshot_get(dunedaq::conffwk::Configuration& db, const std::string& id);\n"
+        << dx << "    static void __snapshot_init(const dunedaq::conffwk::DalObject * obj);\n\n"
+        << dx << "  protected:\n\n"
+        << dx << "    void write_snapshot_data(dunedaq::oksdalgen::SnapshotWriter& out) const;\n\n"
+        << dx << "      // read data of direct attributes and relationships by init(), while the object is read from snapshot\n\n"
+        << dx << "    void read_snapshot_data(dunedaq::oksdalgen::SnapshotReader& in);\n\n\n";
+    }
+
+
+    // generate method used by parallel preloader
+
+  if (options.m_preload)
+    {
+      cpp_file
+        << dx << "  public:\n\n"
+        << dx << "      /**\n"
+        << dx << "       * \\brief Initialize the object, if it was not read yet.\n"
+        << dx << "       *\n"
+        << dx << "       * The method is used by generated preloader to initialize objects by several threads.\n"
+        << dx << "       * The referenced objects are not initialized.\n"
+        << dx << "       */\n\n"
+        << dx << "    void\n"
+        << dx << "    preload() const\n"
+        << dx << "      {\n"
+        << dx << "        std::lock_guard scoped_lock(m_mutex);\n"
+        << dx << "        check();\n"
+        << dx << "        check_init();\n"
+        << dx << "      }\n\n\n";
+    }
+
+
+    // generate JSON methods
+
+  if (options.m_json)
+    {
+      cpp_file
+        << dx << "  public:\n\n"
+        << dx << "      /**\n"
+        << dx << "       * \\brief Write the object in JSON format.\n"
+        << dx << "       *\n"
+        << dx << "       * The object is written as {\"uid\": ..., \"class\": ..., attributes and relationships}.\n"
+        << dx << "       * Relationships are written as identities of objects, composite ones as nested objects.\n"
+        << dx << "       */\n\n"
+        << dx << "    virtual void write_json(dunedaq::oksdalgen::JsonWriter& out) const;\n\n"
+        << dx << "  protected:\n\n"
+        << dx << "      // write direct attributes and relationships; called by write_json() holding the lock of the object\n\n"
+        << dx << "    static void write_json_data(const " << name << "& x, dunedaq::oksdalgen::JsonWriter& out);\n\n\n";
+    }
+
+
+    // generate methods
+
+  if (const std::list<oks::OksMethod*> *mlist = cl->direct_methods())
+    {
+      bool cpp_comment_is_printed = false;
+
+      for (const auto& i : *mlist)
+        {
+
+          // C++ algorithms
+
+          if (oks::OksMethodImplementation * mi = find_cpp_method_implementation(i))
+            {
+              if (cpp_comment_is_printed == false)
+                {
+                  cpp_file << std::endl << dx << "  public:\n\n" << dx << "      // user-defined algorithms\n\n";
+                  cpp_comment_is_printed = true;
+                }
+              else
+                {
+                  cpp_file << "\n\n";
+                }
+
+              // generate description
+
+              print_description(cpp_file, i->get_description(), dx2);
+
+              // generate prototype
+
+              cpp_file << dx << "    " << mi->get_prototype() << ";\n";
+
+
+              // generate public section extension
+
+              std::string public_method_extension = get_public_section(mi);
+              if (!public_method_extension.empty())
+                {
+                  cpp_file << "\n" << "      // extension of method " << cl->get_name() << "::" << i->get_name() << "()\n";
+                  print_indented(cpp_file, public_method_extension, "    ");
+                }
+            }
+
+        }
+    }
+
+
+    // class finished
+
+  cpp_file << dx << "};\n\n";
+
+
+    // generate ostream operators and typedef for iterator
+
+  cpp_file
+    << dx << "  // out stream operator\n\n"
+    << dx << "inline std::ostream& operator<<(std::ostream& s, const " << name << "& obj)\n"
+    << dx << "  {\n"
+    << dx << "    return obj.print_object(s);\n"
+    << dx << "  }\n\n"
+    << dx << "typedef std::vector<const " << name << "*>::const_iterator " << name << "Iterator;\n\n";
+
+
+    // close namespace
+
+  close_cpp_namespace(cpp_file, ns_level);
+
+
+    // declare explicit instantiations of conffwk templates
+
+  if (options.m_extern_templates)
+    {
+      cpp_file << std::endl;
+      gen_template_instantiations(cpp_file, get_full_cpp_class_name(cl, cl_info, cpp_ns_name), "extern template");
+    }
+
+
+    // generate methods epilogues if necessary
+
+  if (const std::list<oks::OksMethod*> * mlist = cl->direct_methods())
+    {
+      for (const auto & i : *mlist)
+        {
+          oks::OksMethodImplementation * mi = find_cpp_method_implementation(i);
+          if (mi && !get_method_header_epilogue(mi).empty())
+            {
+              cpp_file << "  // epilogue of method " << cl->get_name() << "::" << i->get_name() << "()\n";
+              cpp_file << get_method_header_epilogue(mi) << std::endl;
+            }
+        }
+    }
+
+}
+
+
+static void
+set2out(std::ostream& out, const std::set<std::string>& data, bool& is_first)
+{
+  for (const auto& x : data)
+    {
+      if (is_first)
+        is_first = false;
+      else
+        out << ',';
+      out << '\"' << x << "()\"";
+    }
+}
+
+
+  /**
+   *  The function get_algorithms() fills sets of names of methods
+   *  returning objects (ADD_ALGO_N) and single object (ADD_ALGO_1)
+   *  directly defined by the class
+   */
+
+static void
+get_algorithms(const oks::OksClass *cl, std::set<std::string>& algo_n_set, std::set<std::string>& algo_1_set)
+{
+  if (const std::list<oks::OksMethod*> * mlist = cl->direct_methods())
+    {
+      for (const auto& i : *mlist)
+        {
+          if(oks::OksMethodImplementation * mi = find_cpp_method_implementation(i))
+            {
+              std::string prototype(mi->get_prototype());
+              std::string::size_type idx = prototype.find('(');
+
+              if (idx != std::string::npos)
+                {
+                  idx--;
+
+                  // skip spaces between method name and ()
+                  while (isspace(prototype[idx]) && idx > 0)
+                    idx--;
+
+                  // remove method arguments
+                  prototype.erase(idx+1);
+
+                  // find beginning of the method name
+                  while (!isspace(prototype[idx]) && idx > 0)
+                    idx--;
+
+                  if (idx > 0)
+                    {
+                      prototype.erase(0, idx+1);
+
+                      if (get_add_algo_n(mi))
+                        {
+                          algo_n_set.insert(prototype);
+                        }
+                      else if (get_add_algo_1(mi))
+                        {
+                          algo_1_set.insert(prototype);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+struct AlgorithmInfo
+{
+  std::string m_name;                            // method name without "()"; empty for get() of base class
+  bool m_is_n;                                   // ADD_ALGO_N or ADD_ALGO_1
+  std::vector<const oks::OksClass *> m_path;     // superclasses from the class to the one defining the method
+};
+
+
+  /**
+   *  The function is_generated_hierarchy() returns true if the class
+   *  and all its superclasses are generated in this run, i.e. they are
+   *  neither user-defined classes nor classes of other DALs
+   */
+
+static bool
+is_generated_hierarchy(const oks::OksClass *c, const ClassInfo::Map& cl_info)
+{
+  if (cl_info.find(c) != cl_info.end())
+    return false;
+
+  if (const oks::OksClass::FList * sclasses = c->all_super_classes())
+    for (const auto& i : *sclasses)
+      if (cl_info.find(i) != cl_info.end())
+        return false;
+
+  return true;
+}
+
+
+  /**
+   *  The function get_all_algorithms() flattens algorithms of the class
+   *  and of all its superclasses; the order of superclasses and the choice
+   *  of overridden algorithms are the same as ones used by the recursive
+   *  calls of superclass get() methods. A direct superclass having
+   *  not generated classes in its hierarchy is not flattened: its get()
+   *  is called at the same place, since it may be overridden.
+   */
+
+static void
+get_all_algorithms(const oks::OksClass *cl, std::vector<const oks::OksClass *>& path, std::set<std::string>& names, std::vector<AlgorithmInfo>& algos, const ClassInfo::Map& cl_info)
+{
+  std::set<std::string> algo_n_set, algo_1_set;
+
+  get_algorithms(cl, algo_n_set, algo_1_set);
+
+  for (const auto& x : algo_n_set)
+    if (names.insert(x).second)
+      algos.push_back(AlgorithmInfo{x, true, path});
+
+  for (const auto& x : algo_1_set)
+    if (names.insert(x).second)
+      algos.push_back(AlgorithmInfo{x, false, path});
+
+  if (const std::list<std::string*> * slist = cl->direct_super_classes())
+    {
+      for (const auto& i : *slist)
+        {
+          if (const oks::OksClass * c = cl->get_kernel()->find_class(*i))
+            {
+              path.push_back(c);
+
+              if (!is_generated_hierarchy(c, cl_info))
+                algos.push_back(AlgorithmInfo{"", false, path});
+              else
+                get_all_algorithms(c, path, names, algos, cl_info);
+
+              path.pop_back();
+            }
+        }
+    }
+}
+
+
+void
+gen_cpp_body(const oks::OksClass *cl, std::ostream& cpp_s, const std::string& cpp_ns_name, const std::string& cpp_hdr_dir, const ClassInfo::Map& cl_info, const GenerationOptions& options)
+{
+  cpp_s << "#include \"logging/Logging.hpp\"\n\n";
+
+  if (has_chrono_attributes(cl, options))
+    cpp_s << "#include <ctype.h>\n#include <stdio.h>\n#include <string.h>\n\n";
+
+  const std::string name(alnum_name(cl->get_name()));
+
+  std::vector<const oks::OksClass *> all_super_classes;
+  add_ordered_super_classes(cl, all_super_classes);
+
+  std::set<oks::OksClass *> rclasses;
+
+    // for each relationship, include the header file
+
+  if (const std::list<oks::OksRelationship*> * rlist = cl->direct_relationships())
+    {
+      for (const auto& i : *rlist)
+        {
+          oks::OksClass * c = i->get_class_type();
+          if (has_superclass(cl, c) == false && cl != c)
+            {
+              rclasses.insert(c);
+            }
+        }
+    }
+
+  if (const std::list<oks::OksMethod*> * mlist = cl->direct_methods())
+    {
+      for (const auto& i : *mlist)
+        {
+          if (oks::OksMethodImplementation * mi = find_cpp_method_implementation(i))
+            {
+              std::string prototype(mi->get_prototype());
+              std::string::size_type idx = prototype.find('(');
+
+              if (get_add_algo_n(mi) || get_add_algo_1(mi))
+                {
+
+                  if (idx != std::string::npos)
+                    {
+                      idx--;
+
+                      // skip spaces between method name and ()
+                      while (isspace(prototype[idx]) && idx > 0)
+                        idx--;
+
+                      // find beginning of the method name
+                      while (!isspace(prototype[idx]) && idx > 0)
+                        idx--;
+
+                      // remove method name and arguments
+                      prototype.erase(idx + 1);
+
+                      // remove spaces
+                      prototype.erase(std::remove_if(prototype.begin(), prototype.end(), [](unsigned char x)
+                        { return std::isspace(x);}), prototype.end());
+
+                      if (prototype.empty() == false)
+                        {
+                          idx = prototype.find('*');
+                          prototype.erase(idx--);
+
+                          if (idx != std::string::npos)
+                            {
+                              while (isalnum(prototype[idx]) && idx > 0)
+                                idx--;
+
+                              if(idx == 0 && get_add_algo_1(mi) && prototype.find("const") == 0)
+                                prototype.erase(0, 5);
+                              else
+                                prototype.erase(0, idx+1);
+
+                              if (oks::OksClass * c = cl->get_kernel()->find_class(prototype))
+                                rclasses.insert(c);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+  if (!rclasses.empty())
+    {
+      cpp_s << "  // include files for classes used in relationships and algorithms\n\n";
+
+      for (const auto& j : rclasses)
+        {
+          cpp_s << "#include \"" << get_include_dir(j, cl_info, cpp_hdr_dir) << ".hpp\"\n";
+        }
+
+      cpp_s << std::endl << std::endl;
+    }
+
+
+    // open namespace
+
+  int ns_level = open_cpp_namespace(cpp_s, cpp_ns_name);
+  std::string ns_dx = int2dx(ns_level);
+  std::string ns_dx2 = ns_dx + "    ";
+
+  const char * dx  = ns_dx.c_str();    // are used for alignment
+  const char * dx2 = ns_dx2.c_str();
+
+
+    // static objects
+
+  cpp_s << dx << "const std::string& " << name << "::s_class_name(dunedaq::conffwk::DalFactory::instance().get_known_class_name_ref(\"" << name << "\"));\n\n";
+
+  auto budget = options.m_size_budget.find(cl->get_name());
+
+  if (budget != options.m_size_budget.end())
+    cpp_s << dx << "static_assert(sizeof(" << name << ") <= " << budget->second << ", \"size of class " << name << " exceeds budget of " << budget->second << " bytes\");\n\n";
+
+  std::set<std::string> algo_n_set, algo_1_set;
+
+  get_algorithms(cl, algo_n_set, algo_1_set);
+
+
+  cpp_s
+    << dx << "  // the factory initializer\n\n"
+    << dx << "static struct __" << name << "_Registrator\n"
+    << dx << "  {\n"
+    << dx << "    __" << name << "_Registrator()\n"
+    << dx << "      {\n"
+    << dx << "        dunedaq::conffwk::DalFactory::instance().register_dal_class<" << name << ">(\"" << cl->get_name() << "\", {";
+
+    {
+      bool is_first = true;
+      set2out(cpp_s, algo_1_set, is_first);
+      set2out(cpp_s, algo_n_set, is_first);
+    }
+
+  cpp_s << "});\n";
+
+  if (options.m_snapshot)
+    cpp_s << dx << "        dunedaq::oksdalgen::SnapshotReader::register_class(\"" << cl->get_name() << "\", { " << name << "::__snapshot_signature, &" << name << "::__snapshot_get, &" << name << "::__snapshot_init });\n";
+
+  cpp_s
+    << dx << "      }\n"
+    << dx << "  } __" << name << "_registrator;\n\n\n";
+
+
+    // the constructor
+
+  cpp_s
+    << dx << "  // the constructor\n\n"
+    << dx << name << "::" << name << "(conffwk::Configuration& db, const conffwk::ConfigObject& o) noexcept :\n"
+    << dx << "  " << "dunedaq::conffwk::DalObject(db, o)";
+
+
+    // fill member initializer list, if any
+
+  std::list<std::string> initializer_list;
+
+  if(const std::list<std::string*> * slist = cl->direct_super_classes())
+    {
+      for(auto & i : *slist)
+        {
+          initializer_list.push_back(get_full_cpp_class_name(cl->get_kernel()->find_class(*i), cl_info, "") + "(db, o)");
+        }
+    }
+
+  if (const std::list<oks::OksRelationship *> *rlist = cl->direct_relationships())
+    {
+      for (std::list<oks::OksRelationship*>::const_iterator i = rlist->begin(); i != rlist->end(); ++i)
+        {
+          if ((*i)->get_high_cardinality_constraint() != oks::OksRelationship::Many)
+            {
+              initializer_list.push_back(std::string("m_") + alnum_name((*i)->get_name()) + " (nullptr)");
+            }
+        }
+    }
+
+
+  if(const std::list<oks::OksMethod*> * mlist = cl->direct_methods())
+    {
+      for (std::list<oks::OksMethod*>::const_iterator i = mlist->begin(); i != mlist->end(); ++i)
+        {
+          if (oks::OksMethodImplementation * mi = find_cpp_method_implementation(*i))
+            {
+              std::string member_initializer = get_member_initializer_list(mi);
+              member_initializer.erase(remove(member_initializer.begin(), member_initializer.end(), '\n'), member_initializer.end());
+
+              if (!member_initializer.empty())
+                {
+                  initializer_list.push_back(member_initializer);
+                }
+            }
+        }
+    }
+
+  if (initializer_list.empty() == false)
+    {
+      for (auto & i : initializer_list)
+        {
+          cpp_s << ",\n" << dx << "  " << i;
+        }
+
+      cpp_s << std::endl;
+    }
+
+  cpp_s << "\n"
+    << dx << "{\n"
+    << dx << "  ;\n"
+    << dx << "}\n\n\n";
+
+
+    // print method
+ 
+  cpp_s
+    << dx << "void " << name << "::print(unsigned int indent, bool print_header, std::ostream& s) const\n"
+    << dx << "{\n"
+    << dx << "  check_init();\n\n"
+    << dx << "  try {\n";
+
+  if (cl->direct_attributes() || cl->direct_relationships())
+    cpp_s << dx << "    const std::string str(indent+2, ' ');\n";
+
+  cpp_s
+    << '\n'
+    << dx << "    if (print_header)\n"
+    << dx << "      p_hdr(s, indent, s_class_name";
+
+  if(!cpp_ns_name.empty()) {
+    cpp_s << ", \"" << cpp_ns_name << '\"';
+  }
+
+  cpp_s << ");\n";
+
+
+  if (const std::list<std::string*> * slist = cl->direct_super_classes())
+    {
+      cpp_s << "\n\n" << dx << "      // print direct super-classes\n\n";
+
+      for (const auto& i : *slist)
+        cpp_s << dx << "    " << get_full_cpp_class_name(cl->get_kernel()->find_class(*i), cl_info, cpp_ns_name) << "::print(indent, false, s);\n";
+    }
+
+    // members read on first access are read and printed under the lock; super-classes take it themselves
+
+  if (has_lazy_attributes(cl, options) || has_lazy_relationships(cl, options))
+    cpp_s << "\n" << dx << "    std::lock_guard scoped_lock(m_mutex);\n";
+
+  if(const std::list<oks::OksAttribute*> * alist = cl->direct_attributes()) {
+    cpp_s << "\n\n" << dx << "      // print direct attributes\n\n";
+
+    for(const auto& i : *alist) {
+      const std::string aname(alnum_name(i->get_name()));
+      std::string abase = (i->get_format() == oks::OksAttribute::Hex) ? "<dunedaq::conffwk::hex>" : (i->get_format() == oks::OksAttribute::Oct) ? "<dunedaq::conffwk::oct>" : "";
+
+      if (has_lazy_attributes(cl, options))
+        cpp_s << dx << "    __decode_" << aname << "();\n";
+
+      if (i->get_is_multi_values() && get_chrono_type(i, options))
+        cpp_s
+          << dx << "    {\n"
+          << dx << "      std::vector<std::string> values;\n"
+          << dx << "      for (const auto& x : m_" << aname << ")\n"
+          << dx << "        values.push_back(" << (i->get_data_type() == oks::OksData::date_type ? "__date2str" : "__time2str") << "(x));\n"
+          << dx << "      dunedaq::conffwk::p_mv_attr(s, str, s_" << aname << ", values);\n"
+          << dx << "    }\n";
+      else if (i->get_is_multi_values())
+        cpp_s << dx << "    dunedaq::conffwk::p_mv_attr" << abase << "(s, str, s_" << aname << ", m_" << aname << ");\n";
+      else if (is_typed_enum(i, options))
+        cpp_s << dx << "    dunedaq::conffwk::p_sv_attr(s, str, s_" << aname << ", " << capitalize_name(aname) << "::to_std_string(m_" << aname << "));\n";
+      else if (get_chrono_type(i, options))
+        cpp_s << dx << "    dunedaq::conffwk::p_sv_attr(s, str, s_" << aname << ", " << (i->get_data_type() == oks::OksData::date_type ? "__date2str" : "__time2str") << "(m_" << aname << "));\n";
+      else if (is_bit_member(i, options))
+        cpp_s << dx << "    dunedaq::conffwk::p_sv_attr(s, str, s_" << aname << ", static_cast<bool>(m_" << aname << "));\n";
+      else
+        cpp_s << dx << "    dunedaq::conffwk::p_sv_attr" << abase << "(s, str, s_" << aname << ", m_" << aname << ");\n";
+    }
+  }
+
+  if (const std::list<oks::OksRelationship*> * rlist = cl->direct_relationships())
+    {
+      cpp_s << "\n\n" << dx << "      // print direct relationships\n\n";
+
+      for (const auto& i : *rlist)
+        {
+          const std::string rname(alnum_name(i->get_name()));
+
+          if (options.m_lazy_relationships)
+            cpp_s << dx << "    __resolve_" << rname << "();\n";
+
+          if (i->get_high_cardinality_constraint() == oks::OksRelationship::Many)
+            {
+              if (i->get_is_composite())
+                cpp_s << dx << "    dunedaq::conffwk::p_mv_rel(s, str, indent, s_" << rname << ", m_" << rname << ");\n";
+              else
+                cpp_s << dx << "    dunedaq::conffwk::p_mv_rel(s, str, s_" << rname << ", m_" << rname << ");\n";
+            }
+          else
+            {
+              if (i->get_is_composite())
+                cpp_s << dx <<"    dunedaq::conffwk::p_sv_rel(s, str, indent, s_" << rname << ", m_" << rname << ");\n";
+              else
+                cpp_s << dx <<"    dunedaq::conffwk::p_sv_rel(s, str, s_" << rname << ", m_" << rname << ");\n";
+            }
+        }
+    }
+
+  cpp_s << dx << "  }\n"
+        << dx << "  catch (dunedaq::conffwk::Exception & ex) {\n"
+        << dx << "    dunedaq::conffwk::DalObject::p_error(s, ex);\n"
+	<< dx << "  }\n"
+        << dx << "}\n\n\n";
+
+
+   // init method
+
+  {
+    const char * ic_value = (
+      ( cl->direct_relationships() && cl->direct_relationships()->size() ) ||
+      ( cl->direct_super_classes() && cl->direct_super_classes()->size() )
+        ? "init_children"
+        : "/* init_children */"
+    );
+
+    cpp_s
+      << dx << "void " << name << "::init(bool " << ic_value << ")\n"
+      << dx << "{\n";
+  }
+
+  if (cl->direct_super_classes() == nullptr)
+    {
+      cpp_s
+        << dx << "  p_was_read = true;\n"
+        << dx << "  increment_read();\n";
+    }
+
+    // generate initialization for super classes    
+
+  if (const std::list<std::string*> * slist = cl->direct_super_classes())
+    {
+      for (const auto& i : *slist)
+        {
+          cpp_s << dx << "  " << alnum_name(*i) << "::init(init_children);\n";
+        }
+      if (!slist->empty())
+        cpp_s << std::endl;
+    }
+
+  cpp_s << dx << "  TLOG_DEBUG(5) << \"read object \" << this << \" (class \" << s_class_name << \')\';\n";
+
+    // lazy relationships are resolved by getters
+
+  if (has_lazy_attributes(cl, options))
+    cpp_s << "\n" << dx << "  m_decoded_attributes.reset();\n";
+
+  if (has_lazy_relationships(cl, options))
+    cpp_s << "\n" << dx << "  m_resolved_relationships.reset();\n";
+
+    // the data of object are read from snapshot, while it is loaded
+
+  if (options.m_snapshot && has_direct_data(cl))
+    cpp_s
+      << "\n"
+      << dx << "  if (dunedaq::oksdalgen::SnapshotReader * in = dunedaq::oksdalgen::SnapshotReader::reading(this))\n"
+      << dx << "    {\n"
+      << dx << "      read_snapshot_data(*in);\n"
+      << dx << "      return;\n"
+      << dx << "    }\n";
+
+    // put try / catch only if there are attributes or relationships to be initialized
+  const std::list<oks::OksAttribute*> *alist = (has_lazy_attributes(cl, options) ? nullptr : cl->direct_attributes());
+  const std::list<oks::OksRelationship*> *rlist = (options.m_lazy_relationships ? nullptr : cl->direct_relationships());
+
+  if ((alist && !alist->empty()) || (rlist && !rlist->empty()))
+    {
+      cpp_s << std::endl << dx << "  try {\n";
+
+
+      // generate initialization for attributes
+      if (alist)
+        {
+          for (const auto& i : *alist)
+            gen_attribute_read(cpp_s, std::string(dx) + "    ", i, "p_obj.get(s_" + alnum_name(i->get_name()) + ", ", options);
+        }
+
+
+      // generate initialization for relationships
+      if (rlist)
+        {
+          for (const auto& i : *rlist)
+            {
+              const std::string& rname = i->get_name();
+              std::string cpp_name = alnum_name(rname);
+              std::string rcname = get_full_cpp_class_name(i->get_class_type(), cl_info, cpp_ns_name);
+              if (i->get_high_cardinality_constraint() == oks::OksRelationship::Many)
+                {
+                  cpp_s << dx << "    p_db._ref<" << rcname << ">(p_obj, s_" << cpp_name << ", " << "m_" << cpp_name << ", init_children);\n";
+                }
+              else
+                {
+                  cpp_s << dx << "    m_" << cpp_name << " = p_db._ref<" << rcname << ">(p_obj, s_" << cpp_name << ", init_children);\n";
+                }
+            }
+        }
+
+      cpp_s
+        << dx << "  }\n"
+        << dx << "  catch (dunedaq::conffwk::Exception & ex) {\n"
+        << dx << "    throw_init_ex(ex);\n"
+        << dx << "  }\n";
+
+    }
+
+  cpp_s << dx << "}\n\n";
+
+
+    // destructor
+
+  cpp_s
+    << dx << name << "::~" << name << "() noexcept\n"
+    << dx << "{\n"
+    << dx << "}\n\n";
+
+
+    // conversions of date and time attributes; the strings are parsed in ISO ("20240131T235959"),
+    // ISO extended ("2024-01-31 23:59:59") and simple ("2024-Jan-31 23:59:59") formats
+    // and written in ISO format
+
+  if (has_chrono_attributes(cl, options))
+    {
+      cpp_s
+        << dx << "bool " << name << "::__str2time(const std::string& str, std::chrono::sys_seconds& value) noexcept\n"
+        << dx << "{\n"
+        << dx << "  static const char months[] = \"JanFebMarAprMayJunJulAugSepOctNovDec\";\n\n"
+        << dx << "  unsigned int v[6] = { 0, 0, 0, 0, 0, 0 };\n"
+        << dx << "  unsigned int n = 0;\n"
+        << dx << "  const char * p = str.c_str();\n\n"
+        << dx << "  while (*p && n < 6)\n"
+        << dx << "    {\n"
+        << dx << "      if (isdigit(*p))\n"
+        << dx << "        {\n"
+        << dx << "            // fixed width of undelimited fields: 4 digits for year and 2 digits for others\n"
+        << dx << "          for (const char * start = p; isdigit(*p) && (p - start) < (n == 0 ? 4 : 2); ++p)\n"
+        << dx << "            v[n] = v[n] * 10 + (*p - '0');\n"
+        << dx << "          n++;\n"
+        << dx << "        }\n"
+        << dx << "      else if (*p == '-' || *p == ':' || *p == ' ' || (*p == 'T' && n == 3))\n"
+        << dx << "        {\n"
+        << dx << "          p++;\n"
+        << dx << "        }\n"
+        << dx << "      else if (n == 1 && isalpha(*p))\n"
+        << dx << "        {\n"
+        << dx << "          while (v[1] < 12 && strncmp(months + v[1] * 3, p, 3))\n"
+        << dx << "            v[1]++;\n"
+        << dx << "          if (v[1]++ == 12)\n"
+        << dx << "            return false;\n"
+        << dx << "          p += 3;\n"
+        << dx << "          n++;\n"
+        << dx << "        }\n"
+        << dx << "      else\n"
+        << dx << "        {\n"
+        << dx << "          return false;\n"
+        << dx << "        }\n"
+        << dx << "    }\n\n"
+        << dx << "  const std::chrono::year_month_day ymd{std::chrono::year(v[0]), std::chrono::month(v[1]), std::chrono::day(v[2])};\n\n"
+        << dx << "  if (*p || (n != 3 && n != 6) || !ymd.ok() || v[3] > 23 || v[4] > 59 || v[5] > 60)\n"
+        << dx << "    return false;\n\n"
+        << dx << "  value = std::chrono::sys_days(ymd) + std::chrono::hours(v[3]) + std::chrono::minutes(v[4]) + std::chrono::seconds(v[5]);\n\n"
+        << dx << "  return true;\n"
+        << dx << "}\n\n"
+        << dx << "std::string " << name << "::__date2str(std::chrono::sys_days value)\n"
+        << dx << "{\n"
+        << dx << "  const std::chrono::year_month_day ymd(value);\n"
+        << dx << "  char buf[16];\n"
+        << dx << "  snprintf(buf, sizeof(buf), \"%04d%02u%02u\", static_cast<int>(ymd.year()), static_cast<unsigned int>(ymd.month()), static_cast<unsigned int>(ymd.day()));\n"
+        << dx << "  return buf;\n"
+        << dx << "}\n\n"
+        << dx << "std::string " << name << "::__time2str(std::chrono::sys_seconds value)\n"
+        << dx << "{\n"
+        << dx << "  const std::chrono::sys_days days = std::chrono::floor<std::chrono::days>(value);\n"
+        << dx << "  const std::chrono::hh_mm_ss hms(value - days);\n"
+        << dx << "  char buf[16];\n"
+        << dx << "  snprintf(buf, sizeof(buf), \"T%02d%02d%02d\", static_cast<int>(hms.hours().count()), static_cast<int>(hms.minutes().count()), static_cast<int>(hms.seconds().count()));\n"
+        << dx << "  return __date2str(days) + buf;\n"
+        << dx << "}\n\n";
+    }
+
+    // JSON methods
+
+  if (options.m_json)
+    {
+      cpp_s
+        << dx << "void " << name << "::write_json(dunedaq::oksdalgen::JsonWriter& out) const\n"
+        << dx << "{\n"
+        << dx << "  std::lock_guard scoped_lock(m_mutex);\n"
+        << dx << "  check();\n"
+        << dx << "  check_init();\n"
+        << dx << "  out.begin_object();\n"
+        << dx << "  out.key(\"uid\");\n"
+        << dx << "  out.value(UID());\n"
+        << dx << "  out.key(\"class\");\n"
+        << dx << "  out.value(s_class_name);\n";
+
+      for (const auto& i : all_super_classes)
+        cpp_s << dx << "  " << get_full_cpp_class_name(i, cl_info, cpp_ns_name) << "::write_json_data(" << get_super_class_object(cl, i, true, cpp_ns_name, cl_info) << ", out);\n";
+
+      cpp_s
+        << dx << "  write_json_data(*this, out);\n"
+        << dx << "  out.end_object();\n"
+        << dx << "}\n\n"
+        << dx << "void " << name << "::write_json_data(const " << name << "& x, dunedaq::oksdalgen::JsonWriter& out)\n"
+        << dx << "{\n";
+
+      if (const std::list<oks::OksAttribute*> * alist = cl->direct_attributes())
+        for (const auto& i : *alist)
+          {
+            const std::string aname(alnum_name(i->get_name()));
+
+            if (has_lazy_attributes(cl, options))
+              cpp_s << dx << "  x.__decode_" << aname << "();\n";
+
+            cpp_s << dx << "  out.key(s_" << aname << ");\n";
+
+            if (is_typed_enum(i, options))
+              {
+                cpp_s << dx << "  out.value(" << capitalize_name(aname) << "::to_string(x.m_" << aname << "));\n";
+              }
+            else if (get_chrono_type(i, options))
+              {
+                const char * chrono_str = (i->get_data_type() == oks::OksData::date_type ? "__date2str" : "__time2str");
+
+                if (i->get_is_multi_values())
+                  cpp_s
+                    << dx << "  out.begin_array();\n"
+                    << dx << "  for (const auto& v : x.m_" << aname << ")\n"
+                    << dx << "    out.value(" << chrono_str << "(v));\n"
+                    << dx << "  out.end_array();\n";
+                else
+                  cpp_s << dx << "  out.value(" << chrono_str << "(x.m_" << aname << "));\n";
+              }
+            else if (is_bit_member(i, options))
+              {
+                cpp_s << dx << "  out.value(static_cast<bool>(x.m_" << aname << "));\n";
+              }
+            else
+              {
+                const char * base = (i->get_format() == oks::OksAttribute::Hex ? ", 16" : i->get_format() == oks::OksAttribute::Oct ? ", 8" : "");
+                cpp_s << dx << "  out.value(x.m_" << aname << base << ");\n";
+              }
+          }
+
+      if (const std::list<oks::OksRelationship*> * rlist = cl->direct_relationships())
+        for (const auto& i : *rlist)
+          {
+            const std::string rname(alnum_name(i->get_name()));
+
+            if (options.m_lazy_relationships)
+              cpp_s << dx << "  x.__resolve_" << rname << "();\n";
+
+            cpp_s
+              << dx << "  out.key(s_" << rname << ");\n"
+              << dx << "  out." << (i->get_is_composite() ? "object" : "object_id") << "(x.m_" << rname << ");\n";
+          }
+
+      cpp_s << dx << "}\n\n";
+    }
+
+
+    // binary snapshot methods
+
+  if (options.m_snapshot)
+    {
+      cpp_s
+        << dx << "void " << name << "::write_snapshot(dunedaq::oksdalgen::SnapshotWriter& out) const\n"
+        << dx << "{\n"
+        << dx << "  std::lock_guard scoped_lock(m_mutex);\n"
+        << dx << "  check();\n"
+        << dx << "  check_init();\n"
+        << dx << "  write_snapshot_data(out);\n"
+        << dx << "}\n\n"
+        << dx << "void " << name << "::write_snapshot_data(dunedaq::oksdalgen::SnapshotWriter& out) const\n"
+        << dx << "{\n";
+
+      if (const std::list<std::string*> * slist = cl->direct_super_classes())
+        for (const auto& i : *slist)
+          cpp_s << dx << "  " << get_full_cpp_class_name(cl->get_kernel()->find_class(*i), cl_info, cpp_ns_name) << "::write_snapshot_data(out);\n";
+
+      if (const std::list<oks::OksAttribute*> * alist = cl->direct_attributes())
+        for (const auto& i : *alist)
+          {
+            const std::string aname(alnum_name(i->get_name()));
+
+            if (has_lazy_attributes(cl, options))
+              cpp_s << dx << "  __decode_" << aname << "();\n";
+
+            if (is_bit_member(i, options))
+              cpp_s << dx << "  out.write(static_cast<bool>(m_" << aname << "));\n";
+            else
+              cpp_s << dx << "  out.write(m_" << aname << ");\n";
+          }
+
+      if (const std::list<oks::OksRelationship*> * rlist = cl->direct_relationships())
+        for (const auto& i : *rlist)
+          {
+            if (options.m_lazy_relationships)
+              cpp_s << dx << "  __resolve_" << alnum_name(i->get_name()) << "();\n";
+
+            cpp_s << dx << "  out.write_object" << (i->get_high_cardinality_constraint() == oks::OksRelationship::Many ? "s" : "") << "(m_" << alnum_name(i->get_name()) << ");\n";
+          }
+
+      cpp_s
+        << dx << "}\n\n"
+        << dx << "void " << name << "::read_snapshot_data(dunedaq::oksdalgen::SnapshotReader& " << (has_direct_data(cl) ? "in" : "/* in */") << ")\n"
+        << dx << "{\n";
+
+      if (const std::list<oks::OksAttribute*> * alist = cl->direct_attributes())
+        for (const auto& i : *alist)
+          {
+            const std::string aname(alnum_name(i->get_name()));
+
+            if (is_bit_member(i, options))
+              cpp_s
+                << dx << "  {\n"
+                << dx << "    bool value;\n"
+                << dx << "    in.read(value);\n"
+                << dx << "    m_" << aname << " = value;\n"
+                << dx << "  }\n";
+            else
+              cpp_s << dx << "  in.read(m_" << aname << ");\n";
+          }
+
+      if (const std::list<oks::OksRelationship*> * rlist = cl->direct_relationships())
+        for (const auto& i : *rlist)
+          cpp_s << dx << "  in.read_object" << (i->get_high_cardinality_constraint() == oks::OksRelationship::Many ? "s" : "") << "(m_" << alnum_name(i->get_name()) << ");\n";
+
+      if (has_lazy_attributes(cl, options))
+        cpp_s << dx << "  m_decoded_attributes.set();\n";
+
+      if (has_lazy_relationships(cl, options))
+        cpp_s << dx << "  m_resolved_relationships.set();\n";
+
+      cpp_s
+        << dx << "}\n\n"
+        << dx << "const dunedaq::conffwk::DalObject * " << name << "::__snapshot_get(dunedaq::conffwk::Configuration& db, const std::string& id)\n"
+        << dx << "{\n"
+        << dx << "  return db.get<" << name << ">(id, false, false);\n"
+        << dx << "}\n\n"
+        << dx << "void " << name << "::__snapshot_init(const dunedaq::conffwk::DalObject * obj)\n"
+        << dx << "{\n"
+        << dx << "  const " << name << " * x = dynamic_cast<const " << name << " *>(obj);\n"
+        << dx << "  std::lock_guard scoped_lock(x->m_mutex);\n"
+        << dx << "  x->check();\n"
+        << dx << "  x->check_init();\n"
+        << dx << "}\n\n";
+    }
+
+  cpp_s
+    << dx << "std::vector<const dunedaq::conffwk::DalObject *> " << name << "::get(const std::string& name, bool upcast_unregistered) const\n"
+    << dx << "{\n"
+    << dx << "  std::vector<const dunedaq::conffwk::DalObject *> vec;\n\n"
+    << dx << "  if (!__get(name, &name, vec, upcast_unregistered, true))\n"
+    << dx << "    throw_get_ex(name, s_class_name, this);\n\n"
+    << dx << "  return vec;\n"
+    << dx << "}\n\n";
+
+  cpp_s
+    << dx << "std::vector<const dunedaq::conffwk::DalObject *> " << name << "::get(std::string_view name, bool upcast_unregistered) const\n"
+    << dx << "{\n"
+    << dx << "  std::vector<const dunedaq::conffwk::DalObject *> vec;\n\n"
+    << dx << "  if (!__get(name, nullptr, vec, upcast_unregistered, true))\n"
+    << dx << "    throw_get_ex(std::string(name), s_class_name, this);\n\n"
+    << dx << "  return vec;\n"
+    << dx << "}\n\n";
+
+  cpp_s
+    << dx << "bool " << name << "::get(const std::string& name, std::vector<const dunedaq::conffwk::DalObject *>& vec, bool upcast_unregistered, bool first_call) const\n"
+    << dx << "{\n"
+    << dx << "  return __get(name, &name, vec, upcast_unregistered, first_call);\n"
+    << dx << "}\n\n";
+
+  cpp_s
+    << dx << "bool " << name << "::get(std::string_view name, std::vector<const dunedaq::conffwk::DalObject *>& vec, bool upcast_unregistered, bool first_call) const\n"
+    << dx << "{\n"
+    << dx << "  return __get(name, nullptr, vec, upcast_unregistered, first_call);\n"
+    << dx << "}\n\n";
+
+    // the name is passed as string to conffwk and to not flattened base classes;
+    // a string is only created, if the caller passed string_view
+
+  cpp_s
+    << dx << "bool " << name << "::__get(std::string_view name, const std::string * str, std::vector<const dunedaq::conffwk::DalObject *>& vec, bool upcast_unregistered, bool first_call) const\n"
+    << dx << "{\n"
+    << dx << "  if (first_call)\n"
+    << dx << "    {\n"
+    << dx << "      std::lock_guard scoped_lock(m_mutex);\n\n"
+    << dx << "      check();\n"
+    << dx << "      check_init();\n\n"
+    << dx << "        // names of algorithms end by \"()\" and cannot be names of relationships\n\n"
+    << dx << "      if (name.size() < 2 || name.compare(name.size() - 2, 2, \"()\") != 0)\n"
+    << dx << "        if (str ? get_rel_objects(*str, upcast_unregistered, vec) : get_rel_objects(std::string(name), upcast_unregistered, vec))\n"
+    << dx << "          return true;\n"
+    << dx << "    }\n\n";
+
+
+    // flatten algorithms of the class and its superclasses into switches by the length of name;
+    // get() of not flattened base class is called between the switches to keep the order of lookup
+
+    {
+      std::vector<const oks::OksClass *> path;
+      std::set<std::string> names;
+      std::vector<AlgorithmInfo> algos;
+
+      get_all_algorithms(cl, path, names, algos, cl_info);
+
+      std::map<std::string::size_type, std::vector<const AlgorithmInfo *>> by_length;
+
+      auto gen_switch = [&]()
+        {
+          if (by_length.empty())
+            return;
+
+          cpp_s << dx << "  switch (name.size())\n" << dx << "    {\n";
+
+          for (const auto& l : by_length)
+            {
+              cpp_s << dx << "      case " << l.first << ":\n";
+
+              for (const auto& x : l.second)
+                {
+                  std::string object("");
+
+                  for (const auto& c : x->m_path)
+                    object = std::string("static_cast<const ") + get_full_cpp_class_name(c, cl_info, cpp_ns_name) + " *>(" + (object.empty() ? "this" : object) + ")";
+
+                  if (!object.empty())
+                    object += "->";
+
+                  cpp_s
+                    << dx << "        if (name == \"" << x->m_name << "()\")\n"
+                    << dx << "          {\n"
+                    << dx << "            p_db.downcast_dal_object" << (x->m_is_n ? "s" : "") << '(' << object << x->m_name << "(), upcast_unregistered, vec);\n"
+                    << dx << "            return true;\n"
+                    << dx << "          }\n";
+                }
+
+              cpp_s << dx << "        break;\n\n";
+            }
+
+          cpp_s << dx << "      default:\n" << dx << "        break;\n" << dx << "    }\n\n";
+
+          by_length.clear();
+        };
+
+      for (const auto& x : algos)
+        {
+          if (x.m_name.empty())
+            {
+              gen_switch();
+
+              const std::string base(get_full_cpp_class_name(x.m_path.back(), cl_info, cpp_ns_name));
+
+              if (cl_info.find(x.m_path.back()) == cl_info.end())
+                cpp_s << dx << "  if (" << base << "::__get(name, str, vec, upcast_unregistered, false))\n";
+              else
+                cpp_s << dx << "  if (str ? " << base << "::get(*str, vec, upcast_unregistered, false) : " << base << "::get(std::string(name), vec, upcast_unregistered, false))\n";
+
+              cpp_s << dx << "    return true;\n\n";
+            }
+          else
+            {
+              by_length[x.m_name.size() + 2].push_back(&x);
+            }
+        }
+
+      gen_switch();
+    }
+
+  cpp_s
+    << dx << "  if (first_call)\n"
+    << dx << "    return (str ? get_algo_objects(*str, vec) : get_algo_objects(std::string(name), vec));\n\n"
+    << dx << "  return false;\n"
+    << dx << "}\n\n";
+
+
+      // generate decoding of lazy attributes
+
+  if (has_lazy_attributes(cl, options))
+    {
+      unsigned int idx = 0;
+
+      for (const auto& i : *cl->direct_attributes())
+        {
+          const std::string aname(alnum_name(i->get_name()));
+
+          cpp_s
+            << dx << "void " << name << "::__decode_" << aname << "() const\n"
+            << dx << "{\n"
+            << dx << "  if (!m_decoded_attributes[" << idx << "])\n"
+            << dx << "    {\n"
+            << dx << "        // the object is not changed logically, only its cache of attributes\n"
+            << dx << "      dunedaq::conffwk::ConfigObject& obj(const_cast<dunedaq::conffwk::ConfigObject&>(p_obj));\n";
+
+          gen_attribute_read(cpp_s, std::string(dx) + "      ", i, "obj.get(s_" + aname + ", ", options);
+
+          cpp_s
+            << dx << "      m_decoded_attributes.set(" << idx++ << ");\n"
+            << dx << "    }\n"
+            << dx << "}\n\n";
+        }
+    }
+
+
+      // generate relationship set methods and resolution of lazy relationships
+
+  if (const std::list<oks::OksRelationship*> *rlist = cl->direct_relationships())
+    {
+      unsigned int idx = 0;
+
+      for (const auto& i : *rlist)
+        {
+          const std::string rname(alnum_name(i->get_name()));
+          std::string full_cpp_class_name = get_full_cpp_class_name(i->get_class_type(), cl_info, cpp_ns_name);
+
+          cpp_s << dx << "void " << name << "::set_" << rname << "(const ";
+
+          if (i->get_high_cardinality_constraint() == oks::OksRelationship::Many)
+            cpp_s << "std::vector<const " << full_cpp_class_name << "*>& value)\n";
+          else
+            cpp_s << full_cpp_class_name << " * value)\n";
+
+          cpp_s << dx << "{\n";
+
+            // set relationship and forget resolved value in one locked section
+
+          if (options.m_lazy_relationships)
+            {
+              cpp_s
+                << dx << "  std::lock_guard scoped_lock(m_mutex);\n"
+                << dx << "  check();\n"
+                << dx << "  clear();\n";
+
+              if (i->get_high_cardinality_constraint() == oks::OksRelationship::Many)
+                cpp_s
+                  << dx << "  std::vector<const dunedaq::conffwk::ConfigObject*> objs;\n"
+                  << dx << "  objs.reserve(value.size());\n"
+                  << dx << "  for (const auto& x : value)\n"
+                  << dx << "    objs.push_back(&x->config_object());\n"
+                  << dx << "  p_obj.set_objs(s_" << rname << ", objs);\n";
+              else
+                cpp_s << dx << "  p_obj.set_obj(s_" << rname << ", value ? &value->config_object() : nullptr);\n";
+
+              cpp_s << dx << "  m_resolved_relationships.reset(" << idx << ");\n";
+            }
+          else if (i->get_high_cardinality_constraint() == oks::OksRelationship::Many)
+            cpp_s << dx << "  _set_objects(s_" << rname << ", value);\n";
+          else
+            cpp_s << dx << "  _set_object(s_" << rname << ", value);\n";
+
+          cpp_s << dx << "}\n\n";
+
+          if (options.m_lazy_relationships)
+            {
+              cpp_s
+                << dx << "void " << name << "::__resolve_" << rname << "() const\n"
+                << dx << "{\n"
+                << dx << "  if (!m_resolved_relationships[" << idx << "])\n"
+                << dx << "    {\n"
+                << dx << "        // the object is not changed logically, only its cache of relationships\n"
+                << dx << "      dunedaq::conffwk::ConfigObject& obj(const_cast<dunedaq::conffwk::ConfigObject&>(p_obj));\n";
+
+              if (i->get_high_cardinality_constraint() == oks::OksRelationship::Many)
+                cpp_s << dx << "      p_db._ref<" << full_cpp_class_name << ">(obj, s_" << rname << ", m_" << rname << ", false);\n";
+              else
+                cpp_s << dx << "      m_" << rname << " = p_db._ref<" << full_cpp_class_name << ">(obj, s_" << rname << ", false);\n";
+
+              cpp_s
+                << dx << "      m_resolved_relationships.set(" << idx << ");\n"
+                << dx << "    }\n"
+                << dx << "}\n\n";
+            }
+
+          idx++;
+        }
+    }
+
+
+    // generate methods for c++
+
+  if (const std::list<oks::OksMethod*> * mlist = cl->direct_methods())
+    {
+      bool comment_is_printed = false;
+      for (const auto& i : *mlist)
+        {
+          oks::OksMethodImplementation * mi = find_cpp_method_implementation(i);
+
+          if (mi && !get_method_implementation_body(mi).empty())
+            {
+              if (comment_is_printed == false)
+                {
+                  cpp_s << dx << "    // user-defined algorithms\n\n";
+                  comment_is_printed = true;
+                }
+
+              // generate description
+
+              print_description(cpp_s, i->get_description(), dx2);
+
+              // generate prototype
+
+              std::string prototype(mi->get_prototype());
+              std::string::size_type idx = prototype.find('(');
+
+              if (idx != std::string::npos)
+                {
+                  idx--;
+
+                  // skip spaces between method name and ()
+
+                  while (isspace(prototype[idx]) && idx > 0)
+                    idx--;
+
+                  // find beginning of the method name
+
+                  while ((isalnum(prototype[idx]) || prototype[idx] == '_') && idx > 0)
+                    idx--;
+
+                  prototype[idx] = '\n';
+                  std::string s(dx);
+                  s += alnum_name(name);
+                  s += "::";
+                  prototype.insert(idx + 1, s);
+                }
+
+              // Second pass
+              std::string::size_type idx_open_bracket = prototype.find('(');
+              std::string::size_type idx_space = prototype.rfind(' ', idx_open_bracket);
+              std::string::size_type idx_close_bracket = prototype.rfind(')');
+            
+              auto prototype_attrs = prototype.substr(0,idx_space+1);
+              auto prototype_head = prototype.substr(idx_space+1,idx_close_bracket-idx_space);
+              auto prototype_specs = prototype.substr(idx_close_bracket+1);
+
+              for ( const auto& spec : cpp_method_virtual_specifiers ) {
+                  idx = prototype_attrs.find(spec);
+                  if ( idx != std::string::npos) {
+                      prototype_attrs.erase(idx,spec.size());
+                  }
+                  prototype_attrs = trim(prototype_attrs);
+                                    
+                  idx = prototype_specs.find(spec);
+                  if ( idx != std::string::npos) {
+                      prototype_specs.erase(idx,spec.size());
+                  }
+                  prototype_specs = trim(prototype_specs);
+              }
+
+              prototype = prototype_attrs + ' ' + prototype_head + ' ' + prototype_specs;
+
+              cpp_s
+                << dx << prototype << std::endl
+                << dx << "{\n";
+
+              const std::string body(get_method_implementation_body(mi));
+
+              gen_method_prologue(cpp_s, cl, body, dx, options);
+
+              cpp_s
+                << body << std::endl
+                << dx << "}\n\n";
+            }
+        }
+    }
+
+
+    // close namespace
+
+  close_cpp_namespace(cpp_s, ns_level);
+
+
+    // define explicit instantiations of conffwk templates
+
+  if (options.m_extern_templates)
+    {
+      cpp_s << std::endl;
+      gen_template_instantiations(cpp_s, get_full_cpp_class_name(cl, cl_info, cpp_ns_name), "template");
+    }
+}
+
+void
+load_schemas(oks::OksKernel& kernel, const std::list<std::string>& file_names, std::set<oks::OksFile *, std::less<oks::OksFile *> >& file_hs)
+{
+  for (const auto& i : file_names)
+    {
+      if (oks::OksFile * fh = kernel.load_schema(i))
+        {
+          file_hs.insert(fh);
+        }
+      else
+        {
+          std::cerr << "ERROR: can not load schema file \"" << i << "\"\n";
+          exit(EXIT_FAILURE);
+        }
+    }
+}
+
+  /**
+   *  The function gen_common_includes() generates includes and shared types
+   *  used by all generated headers.
+   */
+
+static void
+gen_common_includes(std::ostream& s, const GenerationOptions& options)
+{
+  s <<
+    "#include <stdint.h>   // to define 64 bits types\n"
+    << (options.m_lazy_relationships || !options.m_lazy_attributes.empty() ? "#include <bitset>\n" : "")
+    << (options.m_chrono_dates ? "#include <chrono>\n" : "") <<
+    "#include <iostream>\n"
+    "#include <sstream>\n"
+    "#include <string>\n"
+    "#include <string_view>\n"
+    "#include <map>\n"
+    "#include <vector>\n\n"
+
+    "#include \"conffwk/Configuration.hpp\"\n"
+    "#include \"conffwk/DalObject.hpp\"\n\n";
+
+  if (options.m_reflection)
+    s << "#include \"oksdalgen/Reflection.hpp\"\n\n";
+
+  if (options.m_snapshot)
+    s << "#include \"oksdalgen/Snapshot.hpp\"\n\n";
+
+  if (options.m_json)
+    s << "#include \"oksdalgen/Json.hpp\"\n\n";
+}
+
+
+  /**
+   *  The function get_prelude_header_name() returns name of generated
+   *  prelude header without extension (e.g. "prelude_dunedaq__coredal")
+   */
+
+std::string
+get_prelude_header_name(const std::string& cpp_ns_name)
+{
+  return (cpp_ns_name.empty() ? std::string("prelude") : std::string("prelude_") + alnum_name(cpp_ns_name));
+}
+
+
+void
+gen_cpp_header_prologue(const std::string& file_name,
+                        std::ostream& s,
+			const std::string& cpp_ns_name,
+			const std::string& cpp_hdr_dir,
+			const GenerationOptions& options)
+{
+  s <<
+    "// *** this file is generated by oksdalgen, do not modify it ***\n\n"
+
+    "#ifndef _" << alnum_name(file_name) << "_0_" << alnum_name(cpp_ns_name) << "_0_" << alnum_name(cpp_hdr_dir) << "_H_\n"
+    "#define _" << alnum_name(file_name) << "_0_" << alnum_name(cpp_ns_name) << "_0_" << alnum_name(cpp_hdr_dir) << "_H_\n\n";
+
+  if (options.m_prelude)
+    {
+      s << "#include \"";
+      if (!cpp_hdr_dir.empty())
+        s << cpp_hdr_dir << '/';
+      s << get_prelude_header_name(cpp_ns_name) << ".hpp\"\n\n";
+    }
+  else
+    gen_common_includes(s, options);
+}
+
+
+  /**
+   *  The function gen_prelude_header() generates header with includes and
+   *  shared types, which is included by all classes of the namespace instead
+   *  of their own copies, when --prelude is used.
+   */
+
+void
+gen_prelude_header(std::ostream& s, const std::string& cpp_ns_name, const GenerationOptions& options)
+{
+  std::string guard(get_prelude_header_name(cpp_ns_name));
+  std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+
+  s <<
+    "// *** this file is generated by oksdalgen, do not modify it ***\n\n"
+
+    "#ifndef _" << guard << "_H_\n"
+    "#define _" << guard << "_H_\n\n";
+
+  gen_common_includes(s, options);
+
+  s << "#endif\n";
+}
+
+
+void
+gen_cpp_header_epilogue(std::ostream& s)
+{
+  s << "\n#endif\n";
+}
+
+
+void
+gen_cpp_body_prologue(const std::string& file_name,
+                      std::ostream& src,
+                      const std::string& cpp_hdr_dir)
+{
+  src <<
+    "#include \"conffwk/ConfigObject.hpp\"\n"
+    "#include \"conffwk/DalFactory.hpp\"\n"
+    "#include \"conffwk/DalObjectPrint.hpp\"\n"
+    "#include \"conffwk/Errors.hpp\"\n"
+    "#include \"";
+    if(cpp_hdr_dir != "") {
+      src <<  cpp_hdr_dir << "/";
+    }
+    src << file_name << ".hpp\"\n\n";
+}
+
+
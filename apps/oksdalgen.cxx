@@ -1,4 +1,5 @@
 #include "class_info.hpp"
+#include "stats.hpp"
 
 #include "oks/kernel.hpp"
 #include "oks/class.hpp"
@@ -8,12 +9,20 @@
 
 #include <stdlib.h>
 #include <ctype.h>
+#include <stdio.h>
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iomanip>
 #include <string>
 #include <list>
+#include <memory>
 #include <set>
+#include <sstream>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 using namespace dunedaq;
 using namespace dunedaq::oksdalgen;
@@ -21,1376 +30,488 @@ using namespace dunedaq::oksdalgen;
   // declare external functions
 
 extern std::string alnum_name(const std::string& in);
-extern std::string capitalize_name(const std::string& in);
-extern void print_description(std::ostream& s, const std::string& text, const char * dx);
-extern void print_indented(std::ostream& s, const std::string& text, const char * dx);
-extern std::string get_type(oks::OksData::Type oks_type, bool is_cpp);
-extern void gen_dump_application(std::ostream& s, std::list<std::string>& class_names, const std::string& cpp_ns_name, const std::string& cpp_hdr_dir, const char * conf_header, const char * conf_name, const char * headres_prologue, const char * main_function_prologue);
+extern std::list<std::string> get_derived_first(const oks::OksKernel& kernel, const std::list<std::string>& class_names);
+extern void gen_dump_application(std::ostream& s, std::list<std::string>& class_names, const std::list<std::string>& derived_first_names, const std::string& cpp_ns_name, const std::string& cpp_hdr_dir, const char * conf_header, const char * conf_name, const char * headres_prologue, const char * main_function_prologue, const GenerationOptions& options);
 extern void write_info_file(std::ostream& s, const std::string& cpp_namespace, const std::string& cpp_header_dir, const std::set<const oks::OksClass *, std::less<const oks::OksClass *> >& class_names);
+extern void read_manifest_file(const std::string& file_name, std::map<std::string, std::string>& fingerprints);
+extern void write_manifest_file(std::ostream& s, const std::map<std::string, std::string>& fingerprints);
+extern bool write_file_if_changed(const std::string& file_name, const std::string& data);
+extern std::string get_preload_function_name(const std::string& cpp_ns_name);
+extern void gen_preload_header(std::ostream& s, const std::string& cpp_ns_name);
+extern void gen_preload_body(std::ostream& s, const std::list<std::string>& class_names, const std::string& cpp_ns_name, const std::string& cpp_hdr_dir);
+extern std::string get_prelude_header_name(const std::string& cpp_ns_name);
+extern void gen_prelude_header(std::ostream& s, const std::string& cpp_ns_name, const GenerationOptions& options);
+extern std::string get_umbrella_header_name(const std::string& cpp_ns_name);
+extern void gen_umbrella_header(std::ostream& s, const std::list<std::string>& class_names, const std::string& cpp_ns_name, const std::string& cpp_hdr_dir);
+extern void gen_pch_list(std::ostream& s, const std::string& cpp_hdr_dir, const std::string& prelude_name);
+extern std::string get_fwd_header_name(const std::string& cpp_ns_name);
+extern void gen_fwd_header(std::ostream& s, const std::list<std::string>& class_names, const std::string& cpp_ns_name);
+extern void gen_unity_file(std::ostream& s, const std::vector<std::string>& class_names);
+extern bool file_exists(const std::string& file_name);
 extern std::string get_full_cpp_class_name(const oks::OksClass * c, const ClassInfo::Map& cl_info, const std::string & cpp_ns_name);
 extern std::string get_include_dir(const oks::OksClass * c, const ClassInfo::Map& cl_info, const std::string& cpp_hdr_dir);
 // extern const std::string& get_package_name(const oks::OksClass * c, const ClassInfo::Map& cl_info, const std::string& java_p_name);
-extern void parse_arguments(int argc, char *argv[], std::list<std::string>& class_names, std::list<std::string>& file_names, std::list<std::string>& include_dirs, std::list<std::string>& user_classes, std::string& cpp_dir_name, std::string& cpp_ns_name, std::string& cpp_hdr_dir, std::string& info_file_name, bool& verbose);
-extern bool process_external_class(ClassInfo::Map& cl_info, const oks::OksClass * c, const std::list<std::string>& include_dirs, const std::list<std::string>& user_classes, bool verbose);
-extern std::string int2dx(int level);
-extern int open_cpp_namespace(std::ostream& s, const std::string& value);
-extern void close_cpp_namespace(std::ostream& s, int level);
-extern std::string get_method_header_prologue(oks::OksMethodImplementation *);
-extern std::string get_method_header_epilogue(oks::OksMethodImplementation *);
-extern std::string get_public_section(oks::OksMethodImplementation * mi);
-extern std::string get_private_section(oks::OksMethodImplementation * mi);
-extern std::string get_member_initializer_list(oks::OksMethodImplementation * mi);
-extern std::string get_method_implementation_body(oks::OksMethodImplementation * mi);
+extern void parse_arguments(int argc, char *argv[], std::list<std::string>& class_names, std::list<std::string>& file_names, std::list<std::string>& include_dirs, std::list<std::string>& user_classes, std::string& cpp_dir_name, std::string& cpp_ns_name, std::string& cpp_hdr_dir, std::string& info_file_name, unsigned int& jobs, bool& incremental, unsigned int& unity, std::string& stats_file_name, std::string& trace_file_name, std::string& layout_report_file_name, std::string& include_report_file_name, GenerationOptions& options, bool& verbose);
+extern void build_external_class_index(ExternalClassIndex& index, const std::list<std::string>& include_dirs, const std::list<std::string>& user_classes, bool verbose);
+extern bool process_external_class(ClassInfo::Map& cl_info, const oks::OksClass * c, ExternalClassIndex& index, bool verbose);
+extern oks::OksMethodImplementation * find_cpp_method_implementation(const oks::OksMethod * method);
 extern bool get_add_algo_1(oks::OksMethodImplementation * mi);
 extern bool get_add_algo_n(oks::OksMethodImplementation * mi);
-extern oks::OksMethodImplementation * find_cpp_method_implementation(const oks::OksMethod * method);
+extern void build_class_names_index(const oks::OksKernel& kernel, ClassNamesIndex& index);
+extern void add_method_classes(const oks::OksClass *cl, const ClassNamesIndex& names, std::set<oks::OksClass*>& rclasses);
+extern void gen_header(const oks::OksClass *cl, std::ostream& cpp_file, const std::string& cpp_ns_name, const std::string& cpp_hdr_dir, const ClassInfo::Map& cl_info, const ClassNamesIndex& cl_names, const GenerationOptions& options);
+extern void gen_cpp_body(const oks::OksClass *cl, std::ostream& cpp_s, const std::string& cpp_ns_name, const std::string& cpp_hdr_dir, const ClassInfo::Map& cl_info, const GenerationOptions& options);
+extern void load_schemas(oks::OksKernel& kernel, const std::list<std::string>& file_names, std::set<oks::OksFile *, std::less<oks::OksFile *> >& file_hs);
+extern void gen_cpp_header_prologue(const std::string& file_name, std::ostream& s, const std::string& cpp_ns_name, const std::string& cpp_hdr_dir, const GenerationOptions& options);
+extern void gen_cpp_header_epilogue(std::ostream& s);
+extern void gen_cpp_body_prologue(const std::string& file_name, std::ostream& src, const std::string& cpp_hdr_dir);
+extern void get_data_members(const oks::OksClass *cl, const std::string& cpp_ns_name, const ClassInfo::Map& cl_info, const GenerationOptions& options, std::vector<DataMember>& members);
 
 
   /**
-   *  The function has_superclass returns true if 'tested' class
-   *  has class 'c' as a superclass
+   *  The revision of generated code; increase it when generated code changes
+   *  for the same inputs, so the incremental mode regenerates all classes.
    */
 
-static bool
-has_superclass(const oks::OksClass * tested, const oks::OksClass * c)
-{
-  if (const oks::OksClass::FList * sclasses = tested->all_super_classes())
-    {
-      for (const auto& i : *sclasses)
-        {
-          if (i == c)
-            {
-              return true;
-            }
-        }
-    }
+static const unsigned int fingerprint_revision = 1;
 
-  return false;
-}
-
-const std::string WHITESPACE = " \n\r\t\f\v";
- 
-std::string ltrim(const std::string &s)
-{
-    size_t start = s.find_first_not_of(WHITESPACE);
-    return (start == std::string::npos) ? "" : s.substr(start);
-}
- 
-std::string rtrim(const std::string &s)
-{
-    size_t end = s.find_last_not_of(WHITESPACE);
-    return (end == std::string::npos) ? "" : s.substr(0, end + 1);
-}
- 
-std::string trim(const std::string &s) {
-    return rtrim(ltrim(s));
-}
 
-const std::vector<std::string> cpp_method_virtual_specifiers = {
-    "virtual",
-    "override",
-    "final"
-};
+  /**
+   *  The function get_class_fingerprint() returns hash of all inputs
+   *  defining the generated c++ code of given class: its attributes,
+   *  relationships, super-classes, methods, the namespaces and include
+   *  prefixes of used classes and the generator options.
+   *  It is stored in the manifest file to skip generation of unchanged classes.
+   */
 
-static void
-gen_header(const oks::OksClass *cl,
-           std::ostream& cpp_file,
-           const std::string& cpp_ns_name,
-           const std::string& cpp_hdr_dir,
-           const ClassInfo::Map& cl_info)
+static std::string
+get_class_fingerprint(const oks::OksClass *cl, const std::string& options_str, const GenerationOptions& options, const std::string& cpp_ns_name, const std::string& cpp_hdr_dir, const ClassInfo::Map& cl_info, const ClassNamesIndex& cl_names)
 {
-  const std::string name(alnum_name(cl->get_name()));
+  std::ostringstream s;
 
+  auto add_class = [&](const oks::OksClass * c)
+    {
+      s << "  " << get_full_cpp_class_name(c, cl_info, cpp_ns_name) << ' ' << get_include_dir(c, cl_info, cpp_hdr_dir) << '\n';
+    };
 
-    // get includes for super classes if necessary
+  s << "revision: " << fingerprint_revision << "\n"
+       "options: " << options_str << "\n"
+       "class: " << cl->get_name() << '\n' << cl->get_description() << '\n';
 
-  if (const std::list<std::string*> * super_list = cl->direct_super_classes())
+  if (const std::list<std::string*> * slist = cl->direct_super_classes())
     {
-      cpp_file << "  // include files for classes used in inheritance hierarchy\n\n";
-
-      for (const auto& i : *super_list)
-        {
-          oks::OksClass * c = cl->get_kernel()->find_class(*i);
-          cpp_file << "#include \"" << get_include_dir(c, cl_info, cpp_hdr_dir) << ".hpp\"\n";
-        }
+      s << "direct super-classes:\n";
+      for (const auto& i : *slist)
+        add_class(cl->get_kernel()->find_class(*i));
     }
 
-  cpp_file << std::endl;
-
+  // the generated code depends on data and algorithms of all super-classes
+  // (e.g. inherited algorithms in get() and snapshot signature)
 
-    // generate forward declarations if necessary
+  if (const oks::OksClass::FList * sclasses = cl->all_super_classes())
     {
-      // create set of classes to avoid multiple forward declarations of the same class
-      std::set<oks::OksClass*> rclasses;
-
-      // check direct relationships (c++)
-      if (cl->direct_relationships() && !cl->direct_relationships()->empty())
-        for (const auto &i : *cl->direct_relationships())
-          rclasses.insert(i->get_class_type());
-
-      // check methods
-      if (const std::list<oks::OksMethod*> *mlist = cl->direct_methods())
-        {
-          for (const auto &i : *mlist)
-            {
-              if (oks::OksMethodImplementation *mi = find_cpp_method_implementation(i))
-                {
-                  const std::string mp(mi->get_prototype());
-                  for (const auto &j : cl->get_kernel()->classes())
-                    {
-                      const std::string s(j.second->get_name());
-                      std::string::size_type idx = mp.find(s);
-                      if (idx != std::string::npos && (idx == 0 || !isalnum(mp[idx - 1])) && !isalnum(mp[idx + s.size()]))
-                        rclasses.insert(j.second);
-                    }
-                }
-            }
-        }
-
-      NameSpaceInfo ns_info;
-
-      for (const auto &c : rclasses)
-        {
-          // check if the class' header is not already included
-          if (has_superclass(cl, c) || cl == c)
-            continue;
-
-          ClassInfo::Map::const_iterator idx = cl_info.find(c);
-          ns_info.add((idx != cl_info.end() ? (*idx).second.get_namespace() : cpp_ns_name), alnum_name(c->get_name()));
-        }
-
-      if (!ns_info.empty())
+      s << "all super-classes:\n";
+      for (const auto& i : *sclasses)
         {
-          cpp_file << "  // forward declaration for classes used in relationships and algorithms\n\n";
-          ns_info.print(cpp_file, 0);
-          cpp_file << "\n\n";
+          s << "  " << i->get_name() << '\n';
+
+          if (const std::list<oks::OksAttribute*> * alist = i->direct_attributes())
+            for (const auto& j : *alist)
+              s << "    attribute: " << j->get_name() << ' ' << j->get_type() << ' ' << j->get_is_multi_values() << " [" << j->get_range() << "]\n";
+
+          if (const std::list<oks::OksRelationship*> * rlist = i->direct_relationships())
+            for (const auto& j : *rlist)
+              s << "    relationship: " << j->get_name() << ' ' << j->get_type() << ' ' << j->get_low_cardinality_constraint() << ' ' << j->get_high_cardinality_constraint() << '\n';
+
+          if (const std::list<oks::OksMethod*> * mlist = i->direct_methods())
+            for (const auto& j : *mlist)
+              {
+                s << "    method: " << j->get_name() << '\n';
+                if (oks::OksMethodImplementation * mi = find_cpp_method_implementation(j))
+                  s << "    " << mi->get_prototype() << ' ' << get_add_algo_1(mi) << get_add_algo_n(mi) << '\n';
+              }
         }
     }
 
-    // generate methods prologues if necessary
-
-  if (const std::list<oks::OksMethod*> *mlist = cl->direct_methods())
-    for (const auto &i : *mlist)
-      if (oks::OksMethodImplementation *mi = find_cpp_method_implementation(i))
-        if (!get_method_header_prologue(mi).empty())
-          {
-            cpp_file << "  // prologue of method " << cl->get_name() << "::" << i->get_name() << "()\n";
-            cpp_file << get_method_header_prologue(mi) << std::endl;
-          }
-
-
-    // open namespace
+  if (const std::list<oks::OksAttribute*> * alist = cl->direct_attributes())
+    for (const auto& i : *alist)
+      s << "attribute: " << i->get_name() << ' ' << i->get_type() << ' ' << i->get_is_multi_values() << ' ' << i->get_format() << " [" << i->get_range() << "]\n" << i->get_description() << '\n';
 
-  int ns_level = open_cpp_namespace(cpp_file, cpp_ns_name);
-  std::string ns_dx = int2dx(ns_level);
-  std::string ns_dx2 = ns_dx + "    ";
-  
-  const char * dx  = ns_dx.c_str();    // are used for alignment
-  const char * dx2 = ns_dx2.c_str();
-
-
-    // generate description
-
-  {
-    std::string txt("Declares methods to get and put values of attributes / relationships, to print and to destroy object.\n");
-
-    txt +=
-      "<p>\n"
-      "The methods can throw several exceptions:\n"
-      "<ul>\n"
-      " <li><code>conffwk.NotFoundException</code> - in case of wrong attribute or relationship name (e.g. in case of database schema modification)\n"
-      " <li><code>conffwk.SystemException</code> - in case of system problems (communication or implementation database failure, schema modification, object destruction, etc.)\n"
-      "</ul>\n"
-      "<p>\n"
-      "In addition the methods modifying database (set value, destroy object) can throw <code>conffwk.NotAllowedException</code> "
-      "exception in case, if there are no write access rights or database is already locked by other process.\n";
-
-    if (!cl->get_description().empty())
+  if (const std::list<oks::OksRelationship*> * rlist = cl->direct_relationships())
+    for (const auto& i : *rlist)
       {
-        txt += "\n<p>\n";
-        txt += cl->get_description();
-        txt += "\n";
+        s << "relationship: " << i->get_name() << ' ' << i->get_low_cardinality_constraint() << ' ' << i->get_high_cardinality_constraint() << ' ' << i->get_is_composite() << '\n' << i->get_description() << '\n';
+        add_class(i->get_class_type());
       }
- 
-    txt += "@author oksdalgen\n";
-
-    cpp_file << std::endl;
-    print_description(cpp_file, cl->get_description(), dx);
-  }
-
-    // generate class declaration itself
-
-  cpp_file << dx << "class " << name << " : ";
-
-    // generate inheritance list
-
-  if (const std::list<std::string*> * super_list = cl->direct_super_classes())
-    {
-      for (std::list<std::string*>::const_iterator i = super_list->begin(); i != super_list->end();)
-        {
-          const oks::OksClass * c = cl->get_kernel()->find_class(**i);
-          cpp_file << "public " << get_full_cpp_class_name(c, cl_info, cpp_ns_name);
-          if (++i != super_list->end())
-            cpp_file << ", ";
-        }
-    }
-  else
-    {
-      cpp_file << "public virtual dunedaq::conffwk::DalObject";
-    }
-
-  cpp_file << " {\n\n";
-
-    // generate standard methods
-
-  cpp_file
-    << dx << "  friend class conffwk::Configuration;\n"
-    << dx << "  friend class conffwk::Configuration::Cache<" << name << ">;\n\n"
-    << dx << "  friend class conffwk::DalObject;\n\n"
-    << dx << "  protected:\n\n"
-    << dx << "    " << name << "(conffwk::Configuration& db, const conffwk::ConfigObject& obj) noexcept;\n"
-    << dx << "    virtual ~" << name << "() noexcept;\n"
-    << dx << "    virtual void init(bool init_children);\n\n"
-    << dx << "  public:\n\n"
-    << dx << "      /** The name of the conffwkuration class. */\n\n"
-    << dx << "    static const std::string& s_class_name;\n\n\n"
-    << dx << "      /**\n"
-    << dx << "       * \\brief Print details of the " << name << " object.\n"
-    << dx << "       *\n"
-    << dx << "       * Parameters are:\n"
-    << dx << "       *   \\param offset        number of spaces to shift object right (useful to print nested objects)\n"
-    << dx << "       *   \\param print_header  if false, do not print object header (to print attributes of base classes)\n"
-    << dx << "       *   \\param s             output stream\n"
-    << dx << "       */\n\n"
-    << dx << "    virtual void print(unsigned int offset, bool print_header, std::ostream& s) const;\n\n\n"
-    << dx << "      /**\n"
-    << dx << "       * \\brief Get values of relationships and results of some algorithms as a vector of dunedaq::conffwk::DalObject pointers.\n"
-    << dx << "       *\n"
-    << dx << "       * Parameters are:\n"
-    << dx << "       *   \\param name          name of the relationship or algorithm\n"
-    << dx << "       *   \\return              value of relationship or result of algorithm\n"
-    << dx << "       *   \\throw               std::exception if there is no relationship or algorithm with such name in this and base classes\n"
-    << dx << "       */\n\n"
-    << dx << "    virtual std::vector<const dunedaq::conffwk::DalObject *> get(const std::string& name, bool upcast_unregistered = true) const;\n\n\n"
-    << dx << "  protected:\n\n"
-    << dx << "    bool get(const std::string& name, std::vector<const dunedaq::conffwk::DalObject *>& vec, bool upcast_unregistered, bool first_call) const;\n\n\n";
-
-
-    // generate class attributes and relationships in accordance with
-    // database schema
-
-  if (cl->direct_attributes() || cl->direct_relationships() || cl->direct_methods())
-    {
-      cpp_file << dx << "  private:\n\n";
-
-      // generate attributes:
-      //  - for single attributes this is a normal member variable.
-      //  - for multiple values this is a std::vector<T>.
-
-      if (const std::list<oks::OksAttribute*> * alist = cl->direct_attributes())
-        {
-          for (const auto& i : *alist)
-            {
-              const std::string aname(alnum_name(i->get_name()));
-              std::string cpp_type = get_type(i->get_data_type(), true);
-
-              if (i->get_is_multi_values())
-                cpp_file << dx << "    std::vector<" << cpp_type << "> m_" << aname << ";\n";
-              else
-                cpp_file << dx << "    " << cpp_type << " m_" << aname << ";\n";
-            }
-        }
-
-
-      // generate relationships:
-      //  - for single values this is just a pointer.
-      //  - for multiple values this is a vector of pointers.
-
-      if (const std::list<oks::OksRelationship*> *rlist = cl->direct_relationships())
-        {
-          for (const auto& i : *rlist)
-            {
-              const std::string rname(alnum_name(i->get_name()));
-              const std::string full_class_name(get_full_cpp_class_name(i->get_class_type(), cl_info, cpp_ns_name));
-              if (i->get_high_cardinality_constraint() == oks::OksRelationship::Many)
-                cpp_file << dx << "    std::vector<const " << full_class_name << "*> m_" << rname << ";\n";
-              else
-                cpp_file << dx << "    const " << full_class_name << "* m_" << rname << ";\n";
-            }
-        }
-
-
-      // generate methods extension if any
-
-      if (const std::list<oks::OksMethod*> * mlist = cl->direct_methods())
-        {
-          for (const auto& i : *mlist)
-            {
-              if (oks::OksMethodImplementation * mi = find_cpp_method_implementation(i))
-                {
-                  std::string method_extension = get_private_section(mi);
-                  if (!method_extension.empty())
-                    {
-                      cpp_file << "\n" << dx << "      // extension of method " << cl->get_name() << "::" << i->get_name() << "()\n";
-                      print_indented(cpp_file, method_extension, dx2);
-                    }
-                }
-            }
-        }
-
-
-      cpp_file << std::endl << std::endl << dx << "  public:\n\n";
-
-
-      // generate attribute accessors:
-      //  1. for each attribute generate static std::string with it's name
-      //  2a. for single values this is just:
-      //     - attribute_type attribute_name() const { return m_attribute; }
-      //  2b. for multiple values this is:
-      //     - const std::vector<attribute_type>& attribute_name() const { return m_attribute; }
-
-      if (const std::list<oks::OksAttribute*> *alist = cl->direct_attributes())
-        {
-
-          cpp_file << dx << "      // attribute names\n\n";
-
-          for (const auto& i : *alist)
-            {
-              const std::string& aname(i->get_name());
-              cpp_file << dx << "    inline static const std::string s_" << alnum_name(aname) << " = \"" << aname << "\";\n";
-            }
-
-          cpp_file << "\n";
-
-          for (const auto& i : *alist)
-            {
-              const std::string& cpp_aname(alnum_name(i->get_name()));
-              cpp_file << dx << "    static const std::string& __get_" << cpp_aname << "_str() noexcept { return s_" << cpp_aname << "; }\n";
-            }
-
-          cpp_file << std::endl << std::endl;
-
-          for (const auto& i : *alist)
-            {
-              const std::string aname(alnum_name(i->get_name()));
-
-              // generate enum values
-
-              if (i->get_data_type() == oks::OksData::enum_type && !i->get_range().empty())
-                {
-                  std::string description("Valid enumeration values to compare with value returned by get_");
-                  description += aname;
-                  description += "() and to pass value to set_";
-                  description += aname;
-                  description += "() methods.";
-
-                  print_description(cpp_file, description, dx2);
-
-                  description += "\nUse toString() method to compare and to pass the values. Do not use name() method.";
-
-                  cpp_file << dx << "    struct " << capitalize_name(aname) << " {\n";
-
-                  oks::Oks::Tokenizer t(i->get_range(), ",");
-                  std::string token;
-                  while (!(token = t.next()).empty())
-                    {
-                      cpp_file << dx << "      inline static const std::string " << capitalize_name(alnum_name(token)) << " = \"" << token << "\";\n";
-                    }
-
-                  cpp_file << dx << "    };\n\n";
-                }
-
-              // generate get method description
-
-                {
-
-                  std::string description("Get \"");
-                  description += i->get_name();
-                  description += "\" attribute value.\n\n";
-                  description += i->get_description();
-
-                  std::string description2("\\brief ");
-                  description2 += description;
-                  description2 += "\n\\return the attribute value\n";
-                  description2 += "\\throw dunedaq::conffwk::Generic, dunedaq::conffwk::DeletedObject\n";
-
-                  print_description(cpp_file, description2, dx2);
-                }
-
-              // generate method body
-
-              cpp_file << dx << "    ";
-
-              std::string cpp_type = get_type(i->get_data_type(), true);
-
-              if (i->get_is_multi_values())
-                {
-                  cpp_file << "const std::vector<" << cpp_type << ">&";
-                }
-              else
-                {
-                  if (cpp_type == "std::string")
-                    cpp_file << "const std::string&";
-                  else
-                    cpp_file << cpp_type;
-                }
-
-              cpp_file << '\n'
-                  << dx << "    get_" << aname << "() const\n"
-                  << dx << "      {\n"
-                  << dx << "        std::lock_guard scoped_lock(m_mutex);\n"
-                  << dx << "        check();\n"
-                  << dx << "        check_init();\n"
-                  << dx << "        return m_" << aname << ";\n"
-                  << dx << "      }\n\n";
-
-              // generate set method description
-
-                {
-                  std::string description("Set \"");
-                  description += i->get_name();
-                  description += "\" attribute value.\n\n";
-                  description += i->get_description();
-
-                  std::string description2("\\brief ");
-                  description2 += description;
-                  description2 += "\n\\param value  new attribute value\n";
-                  description2 += "\\throw dunedaq::conffwk::Generic, dunedaq::conffwk::DeletedObject\n";
-
-                  print_description(cpp_file, description2, dx2);
-                }
-
-              // generate set method
-
-              cpp_file << dx << "    void\n" << dx << "    set_" << aname << '(';
-
-              if (i->get_is_multi_values())
-                {
-                  cpp_file << "const std::vector<" << cpp_type << ">&";
-                }
-              else
-                {
-                  if (cpp_type == "std::string")
-                    {
-                      cpp_file << "const std::string&";
-                    }
-                  else
-                    {
-                      cpp_file << cpp_type;
-                    }
-                }
-
-              cpp_file << " value)\n"
-                << dx << "      {\n"
-                << dx << "        std::lock_guard scoped_lock(m_mutex);\n"
-                << dx << "        check();\n"
-                << dx << "        clear();\n"
-                << dx << "        p_obj.";
-
-              if (i->get_data_type() == oks::OksData::string_type && i->get_is_multi_values() == false)
-                {
-                  cpp_file << "set_by_ref";
-                }
-              else if (i->get_data_type() == oks::OksData::enum_type)
-                {
-                  cpp_file << "set_enum";
-                }
-              else if (i->get_data_type() == oks::OksData::class_type)
-                {
-                  cpp_file << "set_class";
-                }
-              else if (i->get_data_type() == oks::OksData::date_type)
-                {
-                  cpp_file << "set_date";
-                }
-              else if (i->get_data_type() == oks::OksData::time_type)
-                {
-                  cpp_file << "set_time";
-                }
-              else
-                {
-                  cpp_file << "set_by_val";
-                }
-
-              cpp_file << "(s_" << aname << ", value);\n"
-                  << dx << "      }\n\n\n";
-            }
-        }
-
-
-      // generate relationship accessors.
-      //  1. for each relationship generate static std::string with it's name
-      //  2a. for single values this is just:
-      //      - const relation_type * relation() const { return m_relation; }
-      //  2b. for multiple values this is:
-      //      - const std::vector<const relation_type*>& relation() const { return m_relation; }
-
-      if (const std::list<oks::OksRelationship*> *rlist = cl->direct_relationships())
-        {
-
-          cpp_file << dx << "      // relationship names\n\n";
-
-          for (const auto& i : *rlist)
-            {
-              const std::string& rname(i->get_name());
-              cpp_file << dx << "    inline static const std::string s_" << alnum_name(rname) << " = \"" << rname << "\";\n";
-            }
-
-          cpp_file << "\n";
-
-          for (const auto& i : *rlist)
-            {
-              const std::string& cpp_rname(alnum_name(i->get_name()));
-              cpp_file << dx << "    static const std::string& __get_" << cpp_rname << "_str() noexcept { return s_" << cpp_rname << "; }\n";
-            }
-
-          cpp_file << std::endl << std::endl;
-
-          for (const auto& i : *rlist)
-            {
-
-              // generate description
-
-                {
-                  std::string description("Get \"");
-                  description += i->get_name();
-                  description += "\" relationship value.\n\n";
-                  description += i->get_description();
-
-                  std::string description2("\\brief ");
-                  description2 += description;
-                  description2 += "\n\\return the relationship value\n";
-                  description2 += "\\throw dunedaq::conffwk::Generic, dunedaq::conffwk::DeletedObject\n";
-
-                  print_description(cpp_file, description2, dx2);
-                }
-
-              // generate method body
-
-              cpp_file << dx << "    const ";
-
-              const std::string rname(alnum_name(i->get_name()));
-              std::string full_cpp_class_name = get_full_cpp_class_name(i->get_class_type(), cl_info, cpp_ns_name);
 
-              if (i->get_high_cardinality_constraint() == oks::OksRelationship::Many)
-                {
-                  cpp_file << "std::vector<const " << full_cpp_class_name << "*>&";
-                }
-              else
-                {
-                  cpp_file << full_cpp_class_name << " *";
-                }
-
-              cpp_file << "\n"
-                  << dx << "    get_" << rname << "() const\n"
-                  << dx << "    {\n"
-                  << dx << "      std::lock_guard scoped_lock(m_mutex);\n"
-                  << dx << "      check();\n"
-                  << dx << "      check_init();\n";
-
-              if (i->get_low_cardinality_constraint() == oks::OksRelationship::One)
-                {
-                  if (i->get_high_cardinality_constraint() == oks::OksRelationship::One)
-                    {
-                      cpp_file
-                          << dx << "      if (!m_" << rname << ")\n"
-                          << dx << "        {\n"
-                          << dx << "          std::ostringstream text;\n"
-                          << dx << "          text << \"relationship \\\"\" << s_" << rname << " << \"\\\" of object \" << this << \" is not set\";\n"
-                          << dx << "          throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());\n"
-                          << dx << "        }\n";
-                    }
-                  else
-                    {
-                      cpp_file
-                          << dx << "      if (m_" << rname << ".empty())\n"
-                          << dx << "        {\n"
-                          << dx << "          std::ostringstream text;\n"
-                          << dx << "          text << \"relationship \\\"\" << s_" << rname << " << \"\\\" of object \" << this << \" is empty\";\n"
-                          << dx << "          throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());\n"
-                          << dx << "        }\n";
-                    }
-                }
-
-              cpp_file
-                  << dx << "      return m_" << rname << ";\n"
-                  << dx << "    }\n\n\n";
-
-              // generate set method
-
-                {
-                  std::string description("Set \"");
-                  description += i->get_name();
-                  description += "\" relationship value.\n\n";
-                  description += i->get_description();
-
-                  std::string description2("\\brief ");
-                  description2 += description;
-                  description2 += "\n\\param value  new relationship value\n";
-                  description2 += "\\throw dunedaq::conffwk::Generic, dunedaq::conffwk::DeletedObject\n";
-
-                  print_description(cpp_file, description2, dx2);
-                }
-
-              cpp_file << dx << "    void\n" << dx << "    set_" << rname << "(const ";
-
-              if (i->get_high_cardinality_constraint() == oks::OksRelationship::Many)
-                {
-                  cpp_file << "std::vector<const " << full_cpp_class_name << "*>&";
-                }
-              else
-                {
-                  cpp_file << full_cpp_class_name << " *";
-                }
-
-              cpp_file << " value);\n\n";
-            }
-        }
-    }
-
-
-    // generate methods
-
-  if (const std::list<oks::OksMethod*> *mlist = cl->direct_methods())
-    {
-      bool cpp_comment_is_printed = false;
-
-      for (const auto& i : *mlist)
-        {
-
-          // C++ algorithms
-
-          if (oks::OksMethodImplementation * mi = find_cpp_method_implementation(i))
-            {
-              if (cpp_comment_is_printed == false)
-                {
-                  cpp_file << std::endl << dx << "  public:\n\n" << dx << "      // user-defined algorithms\n\n";
-                  cpp_comment_is_printed = true;
-                }
-              else
-                {
-                  cpp_file << "\n\n";
-                }
-
-              // generate description
-
-              print_description(cpp_file, i->get_description(), dx2);
-
-              // generate prototype
-
-              cpp_file << dx << "    " << mi->get_prototype() << ";\n";
-
-
-              // generate public section extension
-
-              std::string public_method_extension = get_public_section(mi);
-              if (!public_method_extension.empty())
-                {
-                  cpp_file << "\n" << "      // extension of method " << cl->get_name() << "::" << i->get_name() << "()\n";
-                  print_indented(cpp_file, public_method_extension, "    ");
-                }
-            }
-
-        }
-    }
-
-
-    // class finished
-
-  cpp_file << dx << "};\n\n";
-
-
-    // generate ostream operators and typedef for iterator
-
-  cpp_file
-    << dx << "  // out stream operator\n\n"
-    << dx << "inline std::ostream& operator<<(std::ostream& s, const " << name << "& obj)\n"
-    << dx << "  {\n"
-    << dx << "    return obj.print_object(s);\n"
-    << dx << "  }\n\n"
-    << dx << "typedef std::vector<const " << name << "*>::const_iterator " << name << "Iterator;\n\n";
+  if (const std::list<oks::OksMethod*> * mlist = cl->direct_methods())
+    for (const auto& i : *mlist)
+      {
+        s << "method: " << i->get_name() << '\n' << i->get_description() << '\n';
+        if (oks::OksMethodImplementation * mi = find_cpp_method_implementation(i))
+          s << mi->get_prototype() << '\n' << mi->get_body() << '\n';
+      }
 
+  auto budget = options.m_size_budget.find(cl->get_name());
 
-    // close namespace
+  if (budget != options.m_size_budget.end())
+    s << "size budget: " << budget->second << '\n';
 
-  close_cpp_namespace(cpp_file, ns_level);
+  std::set<oks::OksClass*> rclasses;
+  add_method_classes(cl, cl_names, rclasses);
 
+  s << "method classes:\n";
+  for (const auto& i : std::set<const oks::OksClass*, ClassInfo::SortByName>(rclasses.begin(), rclasses.end()))
+    add_class(i);
 
-    // generate methods epilogues if necessary
+  // 64-bits FNV-1a hash
 
-  if (const std::list<oks::OksMethod*> * mlist = cl->direct_methods())
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (unsigned char c : s.str())
     {
-      for (const auto & i : *mlist)
-        {
-          oks::OksMethodImplementation * mi = find_cpp_method_implementation(i);
-          if (mi && !get_method_header_epilogue(mi).empty())
-            {
-              cpp_file << "  // epilogue of method " << cl->get_name() << "::" << i->get_name() << "()\n";
-              cpp_file << get_method_header_epilogue(mi) << std::endl;
-            }
-        }
+      hash ^= c;
+      hash *= 0x100000001b3ULL;
     }
 
+  std::ostringstream out;
+  out << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return out.str();
 }
 
+  /**
+   *  The structure GeneratedClass keeps c++ header and implementation
+   *  of a class produced by a generation job before they are written to files.
+   */
 
-static void
-set2out(std::ostream& out, const std::set<std::string>& data, bool& is_first)
+struct GeneratedClass
 {
-  for (const auto& x : data)
-    {
-      if (is_first)
-        is_first = false;
-      else
-        out << ',';
-      out << '\"' << x << "()\"";
-    }
-}
-
+  const oks::OksClass * m_class;
+  std::string m_fingerprint;
+  bool m_is_up_to_date;
+  std::string m_header;
+  std::string m_body;
+  std::exception_ptr m_error;
+};
 
 static void
-gen_cpp_body(const oks::OksClass *cl, std::ostream& cpp_s, const std::string& cpp_ns_name, const std::string& cpp_hdr_dir, const ClassInfo::Map& cl_info)
+gen_class(GeneratedClass& out, const std::string& cpp_ns_name, const std::string& cpp_hdr_dir, const ClassInfo::Map& cl_info, const ClassNamesIndex& cl_names, const GenerationOptions& options, Stats * stats, unsigned int thread)
 {
-  cpp_s << "#include \"logging/Logging.hpp\"\n\n";
-
-  const std::string name(alnum_name(cl->get_name()));
-
-  std::set<oks::OksClass *> rclasses;
-
-    // for each relationship, include the header file
-
-  if (const std::list<oks::OksRelationship*> * rlist = cl->direct_relationships())
-    {
-      for (const auto& i : *rlist)
-        {
-          oks::OksClass * c = i->get_class_type();
-          if (has_superclass(cl, c) == false && cl != c)
-            {
-              rclasses.insert(c);
-            }
-        }
-    }
-
-  if (const std::list<oks::OksMethod*> * mlist = cl->direct_methods())
-    {
-      for (const auto& i : *mlist)
-        {
-          if (oks::OksMethodImplementation * mi = find_cpp_method_implementation(i))
-            {
-              std::string prototype(mi->get_prototype());
-              std::string::size_type idx = prototype.find('(');
-
-              if (get_add_algo_n(mi) || get_add_algo_1(mi))
-                {
-
-                  if (idx != std::string::npos)
-                    {
-                      idx--;
-
-                      // skip spaces between method name and ()
-                      while (isspace(prototype[idx]) && idx > 0)
-                        idx--;
-
-                      // find beginning of the method name
-                      while (!isspace(prototype[idx]) && idx > 0)
-                        idx--;
-
-                      // remove method name and arguments
-                      prototype.erase(idx + 1);
-
-                      // remove spaces
-                      prototype.erase(std::remove_if(prototype.begin(), prototype.end(), [](unsigned char x)
-                        { return std::isspace(x);}), prototype.end());
-
-                      if (prototype.empty() == false)
-                        {
-                          idx = prototype.find('*');
-                          prototype.erase(idx--);
-
-                          if (idx != std::string::npos)
-                            {
-                              while (isalnum(prototype[idx]) && idx > 0)
-                                idx--;
-
-                              if(idx == 0 && get_add_algo_1(mi) && prototype.find("const") == 0)
-                                prototype.erase(0, 5);
-                              else
-                                prototype.erase(0, idx+1);
-
-                              if (oks::OksClass * c = cl->get_kernel()->find_class(prototype))
-                                rclasses.insert(c);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-  if (!rclasses.empty())
-    {
-      cpp_s << "  // include files for classes used in relationships and algorithms\n\n";
-
-      for (const auto& j : rclasses)
-        {
-          cpp_s << "#include \"" << get_include_dir(j, cl_info, cpp_hdr_dir) << ".hpp\"\n";
-        }
-
-      cpp_s << std::endl << std::endl;
-    }
-
-
-    // open namespace
-
-  int ns_level = open_cpp_namespace(cpp_s, cpp_ns_name);
-  std::string ns_dx = int2dx(ns_level);
-  std::string ns_dx2 = ns_dx + "    ";
-
-  const char * dx  = ns_dx.c_str();    // are used for alignment
-  const char * dx2 = ns_dx2.c_str();
-
-
-    // static objects
-
-  cpp_s << dx << "const std::string& " << name << "::s_class_name(dunedaq::conffwk::DalFactory::instance().get_known_class_name_ref(\"" << name << "\"));\n\n";
-
-  std::set<std::string> algo_n_set, algo_1_set;
-
-  if (const std::list<oks::OksMethod*> * mlist = cl->direct_methods())
-    {
-      for (const auto& i : *mlist)
-        {
-          if(oks::OksMethodImplementation * mi = find_cpp_method_implementation(i))
-            {
-              std::string prototype(mi->get_prototype());
-              std::string::size_type idx = prototype.find('(');
-
-              if (idx != std::string::npos)
-                {
-                  idx--;
-
-                  // skip spaces between method name and ()
-                  while (isspace(prototype[idx]) && idx > 0)
-                    idx--;
-
-                  // remove method arguments
-                  prototype.erase(idx+1);
-
-                  // find beginning of the method name
-                  while (!isspace(prototype[idx]) && idx > 0)
-                    idx--;
-
-                  if (idx > 0)
-                    {
-                      prototype.erase(0, idx+1);
-
-                      if (get_add_algo_n(mi))
-                        {
-                          algo_n_set.insert(prototype);
-                        }
-                      else if (get_add_algo_1(mi))
-                        {
-                          algo_1_set.insert(prototype);
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-
-  cpp_s
-    << dx << "  // the factory initializer\n\n"
-    << dx << "static struct __" << name << "_Registrator\n"
-    << dx << "  {\n"
-    << dx << "    __" << name << "_Registrator()\n"
-    << dx << "      {\n"
-    << dx << "        dunedaq::conffwk::DalFactory::instance().register_dal_class<" << name << ">(\"" << cl->get_name() << "\", {";
+  const std::string name(alnum_name(out.m_class->get_name()));
 
     {
-      bool is_first = true;
-      set2out(cpp_s, algo_1_set, is_first);
-      set2out(cpp_s, algo_n_set, is_first);
-    }
-
-  cpp_s
-    << "});\n"
-    << dx << "      }\n"
-    << dx << "  } registrator;\n\n\n";
-
-
-    // the constructor
+      Stats::Timer timer(stats, "gen_header", out.m_class->get_name(), thread);
 
-  cpp_s
-    << dx << "  // the constructor\n\n"
-    << dx << name << "::" << name << "(conffwk::Configuration& db, const conffwk::ConfigObject& o) noexcept :\n"
-    << dx << "  " << "dunedaq::conffwk::DalObject(db, o)";
+      std::ostringstream cpp_hdr_file;
 
+      gen_cpp_header_prologue(name, cpp_hdr_file, cpp_ns_name, cpp_hdr_dir, options);
+      gen_header(out.m_class, cpp_hdr_file, cpp_ns_name, cpp_hdr_dir, cl_info, cl_names, options);
+      gen_cpp_header_epilogue(cpp_hdr_file);
 
-    // fill member initializer list, if any
-
-  std::list<std::string> initializer_list;
-
-  if(const std::list<std::string*> * slist = cl->direct_super_classes())
-    {
-      for(auto & i : *slist)
-        {
-          initializer_list.push_back(get_full_cpp_class_name(cl->get_kernel()->find_class(*i), cl_info, "") + "(db, o)");
-        }
+      out.m_header = cpp_hdr_file.str();
+      timer.set_bytes(out.m_header.size());
     }
 
-  if (const std::list<oks::OksRelationship *> *rlist = cl->direct_relationships())
     {
-      for (std::list<oks::OksRelationship*>::const_iterator i = rlist->begin(); i != rlist->end(); ++i)
-        {
-          if ((*i)->get_high_cardinality_constraint() != oks::OksRelationship::Many)
-            {
-              initializer_list.push_back(std::string("m_") + alnum_name((*i)->get_name()) + " (nullptr)");
-            }
-        }
-    }
+      Stats::Timer timer(stats, "gen_cpp_body", out.m_class->get_name(), thread);
 
+      std::ostringstream cpp_src_file;
 
-  if(const std::list<oks::OksMethod*> * mlist = cl->direct_methods())
-    {
-      for (std::list<oks::OksMethod*>::const_iterator i = mlist->begin(); i != mlist->end(); ++i)
-        {
-          if (oks::OksMethodImplementation * mi = find_cpp_method_implementation(*i))
-            {
-              std::string member_initializer = get_member_initializer_list(mi);
-              member_initializer.erase(remove(member_initializer.begin(), member_initializer.end(), '\n'), member_initializer.end());
+      gen_cpp_body_prologue(name, cpp_src_file, cpp_hdr_dir);
+      gen_cpp_body(out.m_class, cpp_src_file, cpp_ns_name, cpp_hdr_dir, cl_info, options);
 
-              if (!member_initializer.empty())
-                {
-                  initializer_list.push_back(member_initializer);
-                }
-            }
-        }
+      out.m_body = cpp_src_file.str();
+      timer.set_bytes(out.m_body.size());
     }
+}
 
-  if (initializer_list.empty() == false)
-    {
-      for (auto & i : initializer_list)
-        {
-          cpp_s << ",\n" << dx << "  " << i;
-        }
-
-      cpp_s << std::endl;
-    }
-
-  cpp_s << "\n"
-    << dx << "{\n"
-    << dx << "  ;\n"
-    << dx << "}\n\n\n";
-
-
-    // print method
- 
-  cpp_s
-    << dx << "void " << name << "::print(unsigned int indent, bool print_header, std::ostream& s) const\n"
-    << dx << "{\n"
-    << dx << "  check_init();\n\n"
-    << dx << "  try {\n";
-
-  if (cl->direct_attributes() || cl->direct_relationships())
-    cpp_s << dx << "    const std::string str(indent+2, ' ');\n";
-
-  cpp_s
-    << '\n'
-    << dx << "    if (print_header)\n"
-    << dx << "      p_hdr(s, indent, s_class_name";
-
-  if(!cpp_ns_name.empty()) {
-    cpp_s << ", \"" << cpp_ns_name << '\"';
-  }
-
-  cpp_s << ");\n";
-
-
-  if (const std::list<std::string*> * slist = cl->direct_super_classes())
-    {
-      cpp_s << "\n\n" << dx << "      // print direct super-classes\n\n";
-
-      for (const auto& i : *slist)
-        cpp_s << dx << "    " << get_full_cpp_class_name(cl->get_kernel()->find_class(*i), cl_info, cpp_ns_name) << "::print(indent, false, s);\n";
-    }
-
-  if(const std::list<oks::OksAttribute*> * alist = cl->direct_attributes()) {
-    cpp_s << "\n\n" << dx << "      // print direct attributes\n\n";
-
-    for(const auto& i : *alist) {
-      const std::string aname(alnum_name(i->get_name()));
-      std::string abase = (i->get_format() == oks::OksAttribute::Hex) ? "<dunedaq::conffwk::hex>" : (i->get_format() == oks::OksAttribute::Oct) ? "<dunedaq::conffwk::oct>" : "";
 
-      if (i->get_is_multi_values())
-        cpp_s << dx << "    dunedaq::conffwk::p_mv_attr" << abase << "(s, str, s_" << aname << ", m_" << aname << ");\n";
-      else
-        cpp_s << dx << "    dunedaq::conffwk::p_sv_attr" << abase << "(s, str, s_" << aname << ", m_" << aname << ");\n";
-    }
-  }
+  /**
+   *  The function gen_classes() generates c++ code of given classes using
+   *  up to 'jobs' threads. The OKS kernel and the classes info are only read.
+   *  An exception thrown while generating a class is stored with the class,
+   *  so the caller reports errors in the order of the classes.
+   */
 
-  if (const std::list<oks::OksRelationship*> * rlist = cl->direct_relationships())
-    {
-      cpp_s << "\n\n" << dx << "      // print direct relationships\n\n";
+static void
+gen_classes(std::vector<GeneratedClass>& classes, unsigned int jobs, const std::string& cpp_ns_name, const std::string& cpp_hdr_dir, const ClassInfo::Map& cl_info, const ClassNamesIndex& cl_names, const GenerationOptions& options, Stats * stats)
+{
+  std::atomic<std::size_t> next(0);
 
-      for (const auto& i : *rlist)
+  auto worker = [&](unsigned int thread)
+    {
+      for (std::size_t idx; (idx = next++) < classes.size();)
         {
-          const std::string rname(alnum_name(i->get_name()));
+          if (classes[idx].m_is_up_to_date)
+            continue;
 
-          if (i->get_high_cardinality_constraint() == oks::OksRelationship::Many)
+          try
             {
-              if (i->get_is_composite())
-                cpp_s << dx << "    dunedaq::conffwk::p_mv_rel(s, str, indent, s_" << rname << ", m_" << rname << ");\n";
-              else
-                cpp_s << dx << "    dunedaq::conffwk::p_mv_rel(s, str, s_" << rname << ", m_" << rname << ");\n";
+              gen_class(classes[idx], cpp_ns_name, cpp_hdr_dir, cl_info, cl_names, options, stats, thread);
             }
-          else
+          catch (...)
             {
-              if (i->get_is_composite())
-                cpp_s << dx <<"    dunedaq::conffwk::p_sv_rel(s, str, indent, s_" << rname << ", m_" << rname << ");\n";
-              else
-                cpp_s << dx <<"    dunedaq::conffwk::p_sv_rel(s, str, s_" << rname << ", m_" << rname << ");\n";
+              classes[idx].m_error = std::current_exception();
             }
         }
-    }
+    };
 
-  cpp_s << dx << "  }\n"
-        << dx << "  catch (dunedaq::conffwk::Exception & ex) {\n"
-        << dx << "    dunedaq::conffwk::DalObject::p_error(s, ex);\n"
-	<< dx << "  }\n"
-        << dx << "}\n\n\n";
+  std::vector<std::thread> threads;
 
+  for (unsigned int i = 1; i < std::min<std::size_t>(jobs, classes.size()); ++i)
+    threads.emplace_back(worker, i);
 
-   // init method
+  worker(0);
 
-  {
-    const char * ic_value = (
-      ( cl->direct_relationships() && cl->direct_relationships()->size() ) ||
-      ( cl->direct_super_classes() && cl->direct_super_classes()->size() )
-        ? "init_children"
-        : "/* init_children */"
-    );
+  for (auto& t : threads)
+    t.join();
+}
 
-    cpp_s
-      << dx << "void " << name << "::init(bool " << ic_value << ")\n"
-      << dx << "{\n";
-  }
 
-  if (cl->direct_super_classes() == nullptr)
-    {
-      cpp_s
-        << dx << "  p_was_read = true;\n"
-        << dx << "  increment_read();\n";
-    }
+  /**
+   *  The function write_layout_report() writes program printing in JSON format
+   *  the sizeof() and alignof() of generated classes and the size of their direct
+   *  data members declared in the order of the schema and in the generated order.
+   *  The program is compiled with the generated headers, so all sizes are computed
+   *  by the compiler. Class names are not escaped since OKS class names are alphanumeric.
+   */
 
-    // generate initialization for super classes    
+static void
+write_layout_report(std::ostream& s, const std::vector<GeneratedClass>& classes, const std::string& cpp_ns_name, const std::string& cpp_hdr_dir, const ClassInfo::Map& cl_info, const GenerationOptions& options)
+{
+  GenerationOptions schema_order(options);
+  schema_order.m_compact_layout = false;
 
-  if (const std::list<std::string*> * slist = cl->direct_super_classes())
-    {
-      for (const auto& i : *slist)
-        {
-          cpp_s << dx << "  " << alnum_name(*i) << "::init(init_children);\n";
-        }
-      if (!slist->empty())
-        cpp_s << std::endl;
-    }
+  const std::string prefix(cpp_hdr_dir.empty() ? std::string() : cpp_hdr_dir + '/');
 
-  cpp_s << dx << "  TLOG_DEBUG(5) << \"read object \" << this << \" (class \" << s_class_name << \')\';\n";
+  s << "  // *** this file is generated by oksdalgen, do not modify it ***\n\n"
+       "#include <stdint.h>\n"
+       "#include <iostream>\n\n";
 
-    // put try / catch only if there are attributes or relationships to be initialized
-  const std::list<oks::OksAttribute*> *alist = cl->direct_attributes();
-  const std::list<oks::OksRelationship*> *rlist = cl->direct_relationships();
+  for (const auto& c : classes)
+    s << "#include \"" << prefix << alnum_name(c.m_class->get_name()) << ".hpp\"\n";
 
-  if ((alist && !alist->empty()) || (rlist && !rlist->empty()))
-    {
-      cpp_s << std::endl << dx << "  try {\n";
+  // the structures mirror data members of classes; the enumeration types are nested into the classes
 
+  auto write_members = [&](const std::string& struct_name, const std::string& class_name, const std::vector<DataMember>& members)
+    {
+      s << "  struct " << struct_name << " {\n";
 
-      // generate initialization for attributes
-      if (alist)
+      for (const auto& m : members)
         {
-          for (const auto& i : *alist)
+          std::string type(m.m_type), qualifier;
+
+          if (type.compare(0, 8, "mutable ") == 0)
             {
-              const std::string cpp_name = alnum_name(i->get_name());
-              cpp_s << dx << "    p_obj.get(s_" << cpp_name << ", m_" << cpp_name << ");\n";
+              qualifier = "mutable ";
+              type.erase(0, 8);
             }
-        }
 
+          if (type.size() > 6 && type.compare(type.size() - 6, 6, "::Enum") == 0)
+            type = class_name + "::" + type;
 
-      // generate initialization for relationships
-      if (rlist)
-        {
-          for (const auto& i : *rlist)
-            {
-              const std::string& rname = i->get_name();
-              std::string cpp_name = alnum_name(rname);
-              std::string rcname = get_full_cpp_class_name(i->get_class_type(), cl_info, cpp_ns_name);
-              if (i->get_high_cardinality_constraint() == oks::OksRelationship::Many)
-                {
-                  cpp_s << dx << "    p_db._ref<" << rcname << ">(p_obj, s_" << cpp_name << ", " << "m_" << cpp_name << ", init_children);\n";
-                }
-              else
-                {
-                  cpp_s << dx << "    m_" << cpp_name << " = p_db._ref<" << rcname << ">(p_obj, s_" << cpp_name << ", init_children);\n";
-                }
-            }
+          s << "    " << qualifier << type << " m_" << m.m_name << (m.m_is_bit ? " : 1" : "") << ";\n";
         }
 
-      cpp_s
-        << dx << "  }\n"
-        << dx << "  catch (dunedaq::conffwk::Exception & ex) {\n"
-        << dx << "    throw_init_ex(ex);\n"
-        << dx << "  }\n";
+      s << "  };\n";
+    };
 
-    }
+  s << "\nnamespace {\n";
 
-  cpp_s << dx << "}\n\n";
-
-
-    // destructor
-
-  cpp_s
-    << dx << name << "::~" << name << "() noexcept\n"
-    << dx << "{\n"
-    << dx << "}\n\n";
-
-  cpp_s
-    << dx << "std::vector<const dunedaq::conffwk::DalObject *> " << name << "::get(const std::string& name, bool upcast_unregistered) const\n"
-    << dx << "{\n"
-    << dx << "  std::vector<const dunedaq::conffwk::DalObject *> vec;\n\n"
-    << dx << "  if (!get(name, vec, upcast_unregistered, true))\n"
-    << dx << "    throw_get_ex(name, s_class_name, this);\n\n"
-    << dx << "  return vec;\n"
-    << dx << "}\n\n";
-
-  cpp_s
-    << dx << "bool " << name << "::get(const std::string& name, std::vector<const dunedaq::conffwk::DalObject *>& vec, bool upcast_unregistered, bool first_call) const\n"
-    << dx << "{\n"
-    << dx << "  if (first_call)\n"
-    << dx << "    {\n"
-    << dx << "      std::lock_guard scoped_lock(m_mutex);\n\n"
-    << dx << "      check();\n"
-    << dx << "      check_init();\n\n"
-    << dx << "      if (get_rel_objects(name, upcast_unregistered, vec))\n"
-    << dx << "        return true;\n"
-    << dx << "    }\n\n";
-
-
-  for (const auto &prototype : algo_n_set)
-    cpp_s
-      << dx << "  if (name == \"" << prototype << "()\")\n"
-      << dx << "    {\n"
-      << dx << "      p_db.downcast_dal_objects(" << prototype << "(), upcast_unregistered, vec);\n"
-      << dx << "      return true;\n"
-      << dx << "    }\n\n";
-
-  for (const auto &prototype : algo_1_set)
-    cpp_s
-      << dx << "  if (name == \"" << prototype << "()\")\n"
-      << dx << "    {\n"
-      << dx << "      p_db.downcast_dal_object(" << prototype << "(), upcast_unregistered, vec);\n"
-      << dx << "      return true;\n"
-      << dx << "    }\n\n";
+  for (const auto& c : classes)
+    {
+      std::vector<DataMember> members, generated;
 
+      get_data_members(c.m_class, cpp_ns_name, cl_info, schema_order, members);
+      get_data_members(c.m_class, cpp_ns_name, cl_info, options, generated);
 
-  if (const std::list<std::string*> * slist = cl->direct_super_classes())
-    {
-      for (const auto& i : *slist)
-        {
-          cpp_s << dx << "  if (" << alnum_name(*i) << "::get(name, vec, upcast_unregistered, false)) return true;\n";
-        }
+      if (members.empty())
+        continue;
 
-      cpp_s << "\n";
-    }
+      const std::string name(alnum_name(c.m_class->get_name()));
+      const std::string full_name(get_full_cpp_class_name(c.m_class, cl_info, cpp_ns_name));
 
-  cpp_s
-    << dx << "  if (first_call)\n"
-    << dx << "    return get_algo_objects(name, vec);\n\n"
-    << dx << "  return false;\n"
-    << dx << "}\n\n";
+      s << '\n';
+      write_members(name + "_schema_order", full_name, members);
+      write_members(name + "_generated_order", full_name, generated);
+    }
 
+  s << "}\n\n"
+       "int\n"
+       "main()\n"
+       "{\n"
+       "  std::cout << \"{\\n  \\\"classes\\\": [\";\n\n";
 
-      // generate relationship set methods
+  bool is_first = true;
 
-  if (const std::list<oks::OksRelationship*> *rlist = cl->direct_relationships())
+  for (const auto& c : classes)
     {
-      for (const auto& i : *rlist)
-        {
-          const std::string rname(alnum_name(i->get_name()));
-          std::string full_cpp_class_name = get_full_cpp_class_name(i->get_class_type(), cl_info, cpp_ns_name);
-
-          cpp_s << dx << "void " << name << "::set_" << rname << "(const ";
+      const std::string name(alnum_name(c.m_class->get_name()));
+      const std::string full_name(get_full_cpp_class_name(c.m_class, cl_info, cpp_ns_name));
 
-          if (i->get_high_cardinality_constraint() == oks::OksRelationship::Many)
-            {
-              cpp_s
-                << "std::vector<const " << full_cpp_class_name << "*>& value)\n"
-                << dx << "{\n"
-                << dx << "  _set_objects(s_" << rname << ", value);\n"
-                << dx << "}\n\n";
-            }
-          else
-            {
-              cpp_s
-                << full_cpp_class_name << " * value)\n"
-                << dx << "{\n"
-                << dx << "  _set_object(s_" << rname << ", value);\n"
-                << dx << "}\n\n";
-            }
-        }
-    }
+      std::vector<DataMember> members;
+      get_data_members(c.m_class, cpp_ns_name, cl_info, schema_order, members);
 
+      s << "  std::cout << \"" << (is_first ? "\\n" : ",\\n") << "    { \\\"name\\\": \\\"" << c.m_class->get_name() << "\\\", \\\"members\\\": " << members.size() << "\"\n"
+           "    \", \\\"sizeof\\\": \" << sizeof(" << full_name << ") << \", \\\"alignof\\\": \" << alignof(" << full_name << ")\n";
 
-    // generate methods for c++
+      if (members.empty())
+        s << "    << \", \\\"schema_order_bytes\\\": 0, \\\"generated_bytes\\\": 0\"";
+      else
+        s << "    << \", \\\"schema_order_bytes\\\": \" << sizeof(" << name << "_schema_order) << \", \\\"generated_bytes\\\": \" << sizeof(" << name << "_generated_order)";
 
-  if (const std::list<oks::OksMethod*> * mlist = cl->direct_methods())
-    {
-      bool comment_is_printed = false;
-      for (const auto& i : *mlist)
-        {
-          oks::OksMethodImplementation * mi = find_cpp_method_implementation(i);
+      auto budget = options.m_size_budget.find(c.m_class->get_name());
 
-          if (mi && !get_method_implementation_body(mi).empty())
-            {
-              if (comment_is_printed == false)
-                {
-                  cpp_s << dx << "    // user-defined algorithms\n\n";
-                  comment_is_printed = true;
-                }
+      if (budget != options.m_size_budget.end())
+        s << "\n    << \", \\\"sizeof_budget\\\": " << budget->second << "\"";
 
-              // generate description
+      s << " << \" }\";\n\n";
+      is_first = false;
+    }
 
-              print_description(cpp_s, i->get_description(), dx2);
+  s << "  std::cout << \"\\n  ]\\n}\" << std::endl;\n\n"
+       "  return 0;\n"
+       "}\n";
+}
 
-              // generate prototype
 
-              std::string prototype(mi->get_prototype());
-              std::string::size_type idx = prototype.find('(');
+  /**
+   *  The function write_include_report() writes size of include closure of
+   *  generated class headers and of the forward declarations header. The
+   *  closure contains all distinct headers included directly or via generated
+   *  headers; the bytes are counted for generated headers only, since other
+   *  headers are not read by oksdalgen. The headers map contains text of
+   *  generated headers by names used in include directives.
+   */
 
-              if (idx != std::string::npos)
-                {
-                  idx--;
+static void
+write_include_report(std::ostream& s, const std::vector<GeneratedClass>& classes, const std::map<std::string, std::string>& headers, const std::string& cpp_hdr_dir, const std::string& fwd_header)
+{
+  const std::string prefix(cpp_hdr_dir.empty() ? std::string() : cpp_hdr_dir + '/');
 
-                  // skip spaces between method name and ()
+  auto write_closure = [&](const std::string& name)
+    {
+      std::set<std::string> includes;
+      std::vector<std::string> stack{name};
+      std::size_t bytes = 0;
 
-                  while (isspace(prototype[idx]) && idx > 0)
-                    idx--;
+      while (!stack.empty())
+        {
+          auto it = headers.find(stack.back());
+          stack.pop_back();
 
-                  // find beginning of the method name
+          if (it == headers.end())
+            continue;
 
-                  while ((isalnum(prototype[idx]) || prototype[idx] == '_') && idx > 0)
-                    idx--;
+          bytes += it->second.size();
 
-                  prototype[idx] = '\n';
-                  std::string s(dx);
-                  s += alnum_name(name);
-                  s += "::";
-                  prototype.insert(idx + 1, s);
-                }
+          std::istringstream text(it->second);
+          std::string line;
 
-              // Second pass
-              std::string::size_type idx_open_bracket = prototype.find('(');
-              std::string::size_type idx_space = prototype.rfind(' ', idx_open_bracket);
-              std::string::size_type idx_close_bracket = prototype.rfind(')');
-            
-              auto prototype_attrs = prototype.substr(0,idx_space+1);
-              auto prototype_head = prototype.substr(idx_space+1,idx_close_bracket-idx_space);
-              auto prototype_specs = prototype.substr(idx_close_bracket+1);
-
-              for ( const auto& spec : cpp_method_virtual_specifiers ) {
-                  idx = prototype_attrs.find(spec);
-                  if ( idx != std::string::npos) {
-                      prototype_attrs.erase(idx,spec.size());
-                  }
-                  prototype_attrs = trim(prototype_attrs);
-                                    
-                  idx = prototype_specs.find(spec);
-                  if ( idx != std::string::npos) {
-                      prototype_specs.erase(idx,spec.size());
-                  }
-                  prototype_specs = trim(prototype_specs);
-              }
+          while (std::getline(text, line))
+            {
+              if (line.compare(0, 8, "#include") != 0)
+                continue;
 
-              prototype = prototype_attrs + ' ' + prototype_head + ' ' + prototype_specs;
+              std::string::size_type begin = line.find_first_of("\"<", 8);
+              std::string::size_type end = (begin == std::string::npos ? begin : line.find_first_of("\">", begin + 1));
 
-              cpp_s
-                << dx << prototype << std::endl
-                << dx << "{\n"
-                << get_method_implementation_body(mi) << std::endl
-                << dx << "}\n\n";
+              if (end != std::string::npos && includes.insert(line.substr(begin + 1, end - begin - 1)).second)
+                stack.push_back(line.substr(begin + 1, end - begin - 1));
             }
         }
-    }
 
+      s << "\"headers\": " << includes.size() << ", \"generated_bytes\": " << bytes;
+    };
 
-    // close namespace
+  s << "{\n  \"fwd_header\": { \"name\": \"" << fwd_header << "\", ";
+  write_closure(fwd_header);
+  s << " },\n  \"classes\": [";
 
-  close_cpp_namespace(cpp_s, ns_level);
-}
+  bool is_first = true;
 
-static void
-load_schemas(oks::OksKernel& kernel, const std::list<std::string>& file_names, std::set<oks::OksFile *, std::less<oks::OksFile *> >& file_hs)
-{
-  for (const auto& i : file_names)
+  for (const auto& c : classes)
     {
-      if (oks::OksFile * fh = kernel.load_schema(i))
-        {
-          file_hs.insert(fh);
-        }
-      else
-        {
-          std::cerr << "ERROR: can not load schema file \"" << i << "\"\n";
-          exit(EXIT_FAILURE);
-        }
+      s << (is_first ? "\n" : ",\n") << "    { \"name\": \"" << c.m_class->get_name() << "\", ";
+      write_closure(prefix + alnum_name(c.m_class->get_name()) + ".hpp");
+      s << " }";
+      is_first = false;
     }
+
+  s << "\n  ]\n}\n";
 }
 
+
+  /**
+   *  The function get_unity_files() distributes generated classes between
+   *  unity files having up to 'unity' classes. The classes are grouped by
+   *  their root generated base class (or by themselves, if they have no
+   *  generated base) and the groups are taken in the order of their names.
+   *  A group is not split between files, unless it is bigger than a file.
+   *  This keeps the grouping stable: a new or removed class only changes
+   *  the files containing its group and, if the group does not fit any
+   *  more, the files following it.
+   */
+
 static void
-gen_cpp_header_prologue(const std::string& file_name,
-                        std::ostream& s,
-			const std::string& cpp_ns_name,
-			const std::string& cpp_hdr_dir)
+get_unity_files(const std::vector<GeneratedClass>& classes, unsigned int unity, std::vector<std::vector<std::string>>& files)
 {
-  s <<
-    "// *** this file is generated by oksdalgen, do not modify it ***\n\n"
+  std::set<const oks::OksClass *> generated;
 
-    "#ifndef _" << alnum_name(file_name) << "_0_" << alnum_name(cpp_ns_name) << "_0_" << alnum_name(cpp_hdr_dir) << "_H_\n"
-    "#define _" << alnum_name(file_name) << "_0_" << alnum_name(cpp_ns_name) << "_0_" << alnum_name(cpp_hdr_dir) << "_H_\n\n"
+  for (const auto& c : classes)
+    generated.insert(c.m_class);
 
-    "#include <stdint.h>   // to define 64 bits types\n"
-    "#include <iostream>\n"
-    "#include <sstream>\n"
-    "#include <string>\n"
-    "#include <map>\n"
-    "#include <vector>\n\n"
+  auto is_root = [&](const oks::OksClass * c)
+    {
+      if (const oks::OksClass::FList * sclasses = c->all_super_classes())
+        for (const auto& i : *sclasses)
+          if (generated.find(i) != generated.end())
+            return false;
 
-    "#include \"conffwk/Configuration.hpp\"\n"
-    "#include \"conffwk/DalObject.hpp\"\n\n";
-}
+      return true;
+    };
 
+  std::map<std::string, std::vector<std::string>> groups;
 
-static void
-gen_cpp_header_epilogue(std::ostream& s)
-{
-  s << "\n#endif\n";
-}
+  for (const auto& c : classes)
+    {
+      std::string root = c.m_class->get_name();
 
+      if (!is_root(c.m_class))
+        {
+          root.clear();
 
-static void
-gen_cpp_body_prologue(const std::string& file_name,
-                      std::ostream& src,
-                      const std::string& cpp_hdr_dir)
-{
-  src <<
-    "#include \"conffwk/ConfigObject.hpp\"\n"
-    "#include \"conffwk/DalFactory.hpp\"\n"
-    "#include \"conffwk/DalObjectPrint.hpp\"\n"
-    "#include \"conffwk/Errors.hpp\"\n"
-    "#include \"";
-    if(cpp_hdr_dir != "") {
-      src <<  cpp_hdr_dir << "/";
+          for (const auto& i : *c.m_class->all_super_classes())
+            if (generated.find(i) != generated.end() && is_root(i) && (root.empty() || i->get_name() < root))
+              root = i->get_name();
+        }
+
+      groups[root].push_back(c.m_class->get_name());
+    }
+
+  std::vector<std::string> file;
+
+  for (const auto& g : groups)
+    {
+      if (file.size() + g.second.size() > unity && !file.empty())
+        {
+          files.push_back(file);
+          file.clear();
+        }
+
+      for (const auto& i : g.second)
+        {
+          file.push_back(i);
+
+          if (file.size() == unity)
+            {
+              files.push_back(file);
+              file.clear();
+            }
+        }
     }
-    src << file_name << ".hpp\"\n\n";
+
+  if (!file.empty())
+    files.push_back(file);
 }
 
 
@@ -1406,9 +527,22 @@ main(int argc, char *argv[])
   std::string cpp_hdr_dir = "";                  // directory for c++ header files
   std::string cpp_ns_name = "";                  // c++ namespace
   std::string info_file_name = "oksdalgen.info"; // name of info file
+  unsigned int jobs = 1;                         // number of generation threads
+  bool incremental = false;                      // skip classes not changed since previous run
+  unsigned int unity = 0;                        // maximum number of classes in unity file (0 - no unity files)
+  std::string stats_file_name;                   // report generation time in JSON format ("-" for stdout)
+  std::string trace_file_name;                   // report generation time in Chrome trace format
+  std::string layout_report_file_name;           // program reporting size of generated classes and of their data members
+  std::string include_report_file_name;          // report size of include closure of generated headers
+  GenerationOptions options;                     // optional features of generated code
   bool verbose = false;
 
-  parse_arguments(argc, argv, class_names, file_names, include_dirs, user_classes, cpp_dir_name, cpp_ns_name, cpp_hdr_dir, info_file_name, verbose);
+  parse_arguments(argc, argv, class_names, file_names, include_dirs, user_classes, cpp_dir_name, cpp_ns_name, cpp_hdr_dir, info_file_name, jobs, incremental, unity, stats_file_name, trace_file_name, layout_report_file_name, include_report_file_name, options, verbose);
+
+  std::unique_ptr<Stats> stats;
+
+  if (!stats_file_name.empty() || !trace_file_name.empty())
+    stats.reset(new Stats());
 
   // init OKS
 
@@ -1418,7 +552,12 @@ main(int argc, char *argv[])
 
   try
     {
-      load_schemas(kernel, file_names, file_hs);
+        {
+          Stats::Timer timer(stats.get(), "load_schemas");
+          load_schemas(kernel, file_names, file_hs);
+        }
+
+      std::unique_ptr<Stats::Timer> timer(new Stats::Timer(stats.get(), "compute_class_set"));
 
       // if no user defined classes, generate all
 
@@ -1491,6 +630,11 @@ main(int argc, char *argv[])
 
       // build set of classes which are external to generated
 
+      timer.reset(new Stats::Timer(stats.get(), "resolve_external_classes"));
+
+      ExternalClassIndex external_classes;
+      build_external_class_index(external_classes, include_dirs, user_classes, verbose);
+
       for (const auto& i : generated_classes)
         {
           if (const std::list<oks::OksRelationship *> * rels = i->direct_relationships())
@@ -1506,7 +650,7 @@ main(int argc, char *argv[])
                     }
                   else if (generated_classes.find(rc) == generated_classes.end())
                     {
-                      if (process_external_class(cl_info, rc, include_dirs, user_classes, verbose) == false)
+                      if (process_external_class(cl_info, rc, external_classes, verbose) == false)
                         {
                           std::cerr << "\nERROR: the class \"" << j->get_type() << "\" is used by the relationship \"" << j->get_name() << "\" of class \"" << i->get_name() << "\".\n"
                               "       The class is not in the list of generated classes, "
@@ -1532,7 +676,7 @@ main(int argc, char *argv[])
                     }
                   else if (generated_classes.find(rc) == generated_classes.end())
                     {
-                      if (process_external_class(cl_info, rc, include_dirs, user_classes, verbose) == false)
+                      if (process_external_class(cl_info, rc, external_classes, verbose) == false)
                         {
                           std::cerr << "\nERROR: the class \"" << rc->get_name() << "\" is direct superclass of class \"" << i->get_name() << "\".\n"
                               "       The class is not in the list of generated classes, "
@@ -1546,19 +690,94 @@ main(int argc, char *argv[])
             }
         }
 
+      timer.reset();
+
       if (error_num != 0)
         {
           std::cerr << "\n*** " << error_num << (error_num == 1 ? " error was" : " errors were") << " found.\n\n";
           return (EXIT_FAILURE);
         }
 
-      for (const auto& cl : generated_classes)
+      // generate classes; the files are written in the order of class names
+      // to report errors in the same order for any number of jobs
+
+      std::vector<GeneratedClass> classes;
+
+      ClassNamesIndex cl_names;
+      build_class_names_index(kernel, cl_names);
+
+      // in incremental mode the fingerprints of classes are compared with ones
+      // stored by previous run in the manifest file next to the info file
+
+      const std::string manifest_file_name = info_file_name + ".manifest";
+      std::map<std::string, std::string> fingerprints;
+
+      if (incremental)
+        {
+          read_manifest_file(manifest_file_name, fingerprints);
+        }
+
+        {
+          std::set<const oks::OksClass *, ClassInfo::SortByName> sorted_classes(generated_classes.begin(), generated_classes.end());
+
+          const std::string options_str = cpp_ns_name + ' ' + cpp_hdr_dir + options.str();
+
+          classes.reserve(sorted_classes.size());
+
+          for (const auto& cl : sorted_classes)
+            {
+              GeneratedClass c{cl, "", false, "", "", nullptr};
+
+              if (incremental)
+                {
+                  const std::string name(alnum_name(cl->get_name()));
+
+                  c.m_fingerprint = get_class_fingerprint(cl, options_str, options, cpp_ns_name, cpp_hdr_dir, cl_info, cl_names);
+
+                  auto x = fingerprints.find(cl->get_name());
+
+                  c.m_is_up_to_date = (
+                    x != fingerprints.end() && x->second == c.m_fingerprint &&
+                    file_exists(cpp_dir_name + "/" + name + ".hpp") &&
+                    file_exists(cpp_dir_name + "/" + name + ".cpp")
+                  );
+
+                  if (verbose)
+                    std::cout << " * class \"" << cl->get_name() << "\" is " << (c.m_is_up_to_date ? "up-to-date" : "changed") << std::endl;
+                }
+
+              classes.push_back(c);
+            }
+        }
+
+        {
+          Stats::Timer timer(stats.get(), "generate_classes");
+          gen_classes(classes, jobs, cpp_ns_name, cpp_hdr_dir, cl_info, cl_names, options, stats.get());
+        }
+
+      timer.reset(new Stats::Timer(stats.get(), "write_class_files"));
+
+      for (const auto& c : classes)
         {
-          std::string name(alnum_name(cl->get_name()));
+          if (c.m_error)
+            std::rethrow_exception(c.m_error);
+
+          if (c.m_is_up_to_date)
+            continue;
+
+          std::string name(alnum_name(c.m_class->get_name()));
 
           std::string cpp_hdr_name = cpp_dir_name + "/" + name + ".hpp";
           std::string cpp_src_name = cpp_dir_name + "/" + name + ".cpp";
 
+          if (incremental)
+            {
+              if (!write_file_if_changed(cpp_hdr_name, c.m_header) || !write_file_if_changed(cpp_src_name, c.m_body))
+                return (EXIT_FAILURE);
+
+              continue;
+            }
+
           std::ofstream cpp_hdr_file(cpp_hdr_name.c_str());
           std::ofstream cpp_src_file(cpp_src_name.c_str());
 
@@ -1574,15 +793,40 @@ main(int argc, char *argv[])
               return (EXIT_FAILURE);
             }
 
-          gen_cpp_header_prologue(name, cpp_hdr_file, cpp_ns_name, cpp_hdr_dir);
-          gen_cpp_body_prologue(name, cpp_src_file, cpp_hdr_dir);
+          cpp_hdr_file << c.m_header;
+          cpp_src_file << c.m_body;
+        }
+
+      // generate unity files; the files left from previous run with bigger number of files are removed
+
+      if (unity)
+        {
+          timer.reset(new Stats::Timer(stats.get(), "write_unity_files"));
+
+          const std::string unity_name = cpp_dir_name + "/unity" + (cpp_ns_name.empty() ? std::string() : '_' + alnum_name(cpp_ns_name)) + '_';
 
-          gen_header(cl, cpp_hdr_file, cpp_ns_name, cpp_hdr_dir, cl_info);
-          gen_cpp_body(cl, cpp_src_file, cpp_ns_name, cpp_hdr_dir, cl_info);
+          std::vector<std::vector<std::string>> files;
+          get_unity_files(classes, unity, files);
+
+          for (std::size_t i = 0; i < files.size(); ++i)
+            {
+              std::ostringstream src;
+              gen_unity_file(src, files[i]);
+
+              if (!write_file_if_changed(unity_name + std::to_string(i) + ".cpp", src.str()))
+                return (EXIT_FAILURE);
+            }
 
-          gen_cpp_header_epilogue(cpp_hdr_file);
+          for (std::size_t i = files.size(); file_exists(unity_name + std::to_string(i) + ".cpp"); ++i)
+            if (remove((unity_name + std::to_string(i) + ".cpp").c_str()) != 0)
+              {
+                std::cerr << "ERROR: can not remove file \"" << unity_name << i << ".cpp\"\n";
+                return (EXIT_FAILURE);
+              }
         }
 
+      timer.reset(new Stats::Timer(stats.get(), "gen_dump_application"));
+
       // generate dump applications
 
         {
@@ -1612,6 +856,17 @@ main(int argc, char *argv[])
                 }
               dump_name += ".cpp";
 
+              if (incremental)
+                {
+                  std::ostringstream dmp;
+                  gen_dump_application(dmp, class_names, get_derived_first(kernel, class_names), cpp_ns_name, cpp_hdr_dir, confs[i].header, confs[i].class_name, confs[i].header_prologue, confs[i].main_function_prologue, options);
+
+                  if (!write_file_if_changed(dump_name, dmp.str()))
+                    return (EXIT_FAILURE);
+
+                  continue;
+                }
+
               std::ofstream dmp(dump_name.c_str());
 
               dmp.exceptions(std::ostream::failbit | std::ostream::badbit);
@@ -1620,7 +875,7 @@ main(int argc, char *argv[])
                 {
                   try
                     {
-                      gen_dump_application(dmp, class_names, cpp_ns_name, cpp_hdr_dir, confs[i].header, confs[i].class_name, confs[i].header_prologue, confs[i].main_function_prologue);
+                      gen_dump_application(dmp, class_names, get_derived_first(kernel, class_names), cpp_ns_name, cpp_hdr_dir, confs[i].header, confs[i].class_name, confs[i].header_prologue, confs[i].main_function_prologue, options);
                     }
                   catch (std::exception& ex)
                     {
@@ -1635,6 +890,68 @@ main(int argc, char *argv[])
             }
         }
 
+      // generate parallel preloader
+
+      if (options.m_preload)
+        {
+          timer.reset(new Stats::Timer(stats.get(), "gen_preload"));
+
+          const std::string preload_name = cpp_dir_name + "/" + get_preload_function_name(cpp_ns_name);
+
+          std::ostringstream hdr, src;
+          gen_preload_header(hdr, cpp_ns_name);
+          gen_preload_body(src, get_derived_first(kernel, class_names), cpp_ns_name, cpp_hdr_dir);
+
+          if (!write_file_if_changed(preload_name + ".hpp", hdr.str()) || !write_file_if_changed(preload_name + ".cpp", src.str()))
+            return (EXIT_FAILURE);
+        }
+
+      // generated headers used by include report
+
+      std::map<std::string, std::string> headers;
+      const std::string hdr_prefix(cpp_hdr_dir.empty() ? std::string() : cpp_hdr_dir + '/');
+
+      // generate prelude, umbrella header and list of precompiled headers;
+      // they are rewritten only when changed to keep precompiled header valid
+
+      if (options.m_prelude)
+        {
+          timer.reset(new Stats::Timer(stats.get(), "gen_prelude"));
+
+          const std::string prelude_name = get_prelude_header_name(cpp_ns_name);
+
+          std::ostringstream prelude, umbrella, pch;
+          gen_prelude_header(prelude, cpp_ns_name, options);
+          gen_umbrella_header(umbrella, class_names, cpp_ns_name, cpp_hdr_dir);
+          gen_pch_list(pch, cpp_hdr_dir, prelude_name);
+
+          headers[hdr_prefix + prelude_name + ".hpp"] = prelude.str();
+
+          if (
+            !write_file_if_changed(cpp_dir_name + "/" + prelude_name + ".hpp", prelude.str()) ||
+            !write_file_if_changed(cpp_dir_name + "/" + get_umbrella_header_name(cpp_ns_name) + ".hpp", umbrella.str()) ||
+            !write_file_if_changed(cpp_dir_name + "/" + prelude_name + ".pch", pch.str())
+          )
+            return (EXIT_FAILURE);
+        }
+
+      // generate forward declarations header
+
+      const std::string fwd_header_name = get_fwd_header_name(cpp_ns_name) + ".hpp";
+
+      if (options.m_fwd_header || !include_report_file_name.empty())
+        {
+          std::ostringstream fwd;
+          gen_fwd_header(fwd, class_names, cpp_ns_name);
+
+          if (options.m_fwd_header && !write_file_if_changed(cpp_dir_name + "/" + fwd_header_name, fwd.str()))
+            return (EXIT_FAILURE);
+
+          headers[hdr_prefix + fwd_header_name] = fwd.str();
+        }
+
+      timer.reset(new Stats::Timer(stats.get(), "write_info_file"));
+
       // generate info file
 
         {
@@ -1651,6 +968,113 @@ main(int argc, char *argv[])
             }
         }
 
+      // generate manifest file
+
+      if (incremental)
+        {
+          fingerprints.clear();
+
+          for (const auto& c : classes)
+            fingerprints[c.m_class->get_name()] = c.m_fingerprint;
+
+          std::ostringstream manifest;
+          write_manifest_file(manifest, fingerprints);
+
+          if (!write_file_if_changed(manifest_file_name, manifest.str()))
+            return (EXIT_FAILURE);
+        }
+
+      timer.reset();
+
+      // report generation time
+
+      if (!stats_file_name.empty())
+        {
+          if (stats_file_name == "-")
+            {
+              stats->write_json(std::cout);
+            }
+          else
+            {
+              std::ofstream f(stats_file_name.c_str());
+
+              if (f)
+                {
+                  stats->write_json(f);
+                }
+              else
+                {
+                  std::cerr << "ERROR: can not create file \"" << stats_file_name << "\"\n";
+                  return (EXIT_FAILURE);
+                }
+            }
+        }
+
+      if (!trace_file_name.empty())
+        {
+          std::ofstream f(trace_file_name.c_str());
+
+          if (f)
+            {
+              stats->write_trace(f);
+            }
+          else
+            {
+              std::cerr << "ERROR: can not create file \"" << trace_file_name << "\"\n";
+              return (EXIT_FAILURE);
+            }
+        }
+
+      // report estimated size of data members
+
+      if (!layout_report_file_name.empty())
+        {
+          std::ofstream f(layout_report_file_name.c_str());
+
+          if (f)
+            {
+              write_layout_report(f, classes, cpp_ns_name, cpp_hdr_dir, cl_info, options);
+            }
+          else
+            {
+              std::cerr << "ERROR: can not create file \"" << layout_report_file_name << "\"\n";
+              return (EXIT_FAILURE);
+            }
+        }
+
+
+      // report size of include closure; headers of up-to-date classes are read from files
+
+      if (!include_report_file_name.empty())
+        {
+          for (const auto& c : classes)
+            {
+              const std::string name(alnum_name(c.m_class->get_name()) + ".hpp");
+
+              if (c.m_is_up_to_date)
+                {
+                  std::ifstream f(cpp_dir_name + "/" + name);
+                  std::ostringstream text;
+                  text << f.rdbuf();
+                  headers[hdr_prefix + name] = text.str();
+                }
+              else
+                headers[hdr_prefix + name] = c.m_header;
+            }
+
+          std::ofstream f(include_report_file_name.c_str());
+
+          if (f)
+            {
+              write_include_report(f, classes, headers, cpp_hdr_dir, hdr_prefix + fwd_header_name);
+            }
+          else
+            {
+              std::cerr << "ERROR: can not create file \"" << include_report_file_name << "\"\n";
+              return (EXIT_FAILURE);
+            }
+        }
+
     }
   catch (oks::exception & ex)
     {
@@ -0,0 +1,607 @@
+#include "class_info.hpp"
+
+#include "oks/kernel.hpp"
+#include "oks/class.hpp"
+#include "oks/relationship.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <errno.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace dunedaq;
+using namespace dunedaq::oksdalgen;
+
+  // declare external functions
+
+extern std::list<std::string> get_derived_first(const oks::OksKernel& kernel, const std::list<std::string>& class_names);
+extern void gen_dump_application(std::ostream& s, std::list<std::string>& class_names, const std::list<std::string>& derived_first_names, const std::string& cpp_ns_name, const std::string& cpp_hdr_dir, const char * conf_header, const char * conf_name, const char * headres_prologue, const char * main_function_prologue, const GenerationOptions& options);
+extern void write_info_file(std::ostream& s, const std::string& cpp_namespace, const std::string& cpp_header_dir, const std::set<const oks::OksClass *, std::less<const oks::OksClass *> >& class_names);
+extern void build_external_class_index(ExternalClassIndex& index, const std::list<std::string>& include_dirs, const std::list<std::string>& user_classes, bool verbose);
+extern bool process_external_class(ClassInfo::Map& cl_info, const oks::OksClass * c, ExternalClassIndex& index, bool verbose);
+extern void build_class_names_index(const oks::OksKernel& kernel, ClassNamesIndex& index);
+extern void gen_header(const oks::OksClass *cl, std::ostream& cpp_file, const std::string& cpp_ns_name, const std::string& cpp_hdr_dir, const ClassInfo::Map& cl_info, const ClassNamesIndex& cl_names, const GenerationOptions& options);
+extern void gen_cpp_body(const oks::OksClass *cl, std::ostream& cpp_s, const std::string& cpp_ns_name, const std::string& cpp_hdr_dir, const ClassInfo::Map& cl_info, const GenerationOptions& options);
+extern void load_schemas(oks::OksKernel& kernel, const std::list<std::string>& file_names, std::set<oks::OksFile *, std::less<oks::OksFile *> >& file_hs);
+
+
+static void
+usage()
+{
+  std::cout <<
+    "usage: oksdalgen_benchmark [-c | --classes number]\n"
+    "                           [-a | --attributes number]\n"
+    "                           [-r | --relationships number]\n"
+    "                           [-l | --inheritance-depth number]\n"
+    "                           [-m | --methods number]\n"
+    "                           [-e | --external-dirs number]\n"
+    "                           [-x | --external-classes number]\n"
+    "                           [-n | --repeat number]\n"
+    "                           [-w | --work-dir directory-name]\n"
+    "                           [-o | --out-file file-name]\n"
+    "                           [-h | --help]\n"
+    "\n"
+    "Options/Arguments:\n"
+    "       -c number            number of generated classes (default 100)\n"
+    "       -a number            number of attributes per class (default 10)\n"
+    "       -r number            number of relationships per class (default 4)\n"
+    "       -l number            depth of inheritance hierarchy (default 3)\n"
+    "       -m number            number of c++ methods per class (default 2)\n"
+    "       -e number            number of include directories with oksdalgen.info files (default 4)\n"
+    "       -x number            number of classes per include directory (default 20)\n"
+    "       -n number            number of repetitions of each measurement (default 5)\n"
+    "       -w directory-name    directory for synthetic schema files (default \".\")\n"
+    "       -o file-name         write results into file instead of standard output\n"
+    "       -h                   this message\n"
+    "\n"
+    "Description:\n"
+    "       The utility synthesizes OKS schema files and measures time spent\n"
+    "       by oksdalgen generation phases. The results are printed in JSON format.\n\n";
+}
+
+static void
+no_param(const char * s)
+{
+  std::cerr << "ERROR: the required argument for option \'" << s << "\' is missing\n\n";
+  exit(EXIT_FAILURE);
+}
+
+struct Parameters
+{
+  unsigned int m_classes = 100;
+  unsigned int m_attributes = 10;
+  unsigned int m_relationships = 4;
+  unsigned int m_inheritance_depth = 3;
+  unsigned int m_methods = 2;
+  unsigned int m_external_dirs = 4;
+  unsigned int m_external_classes = 20;
+  unsigned int m_repeat = 5;
+  std::string m_work_dir = ".";
+  std::string m_out_file;
+};
+
+
+  /**
+   *  Functions to synthesize OKS schema files.
+   */
+
+static std::string
+xml_attr(const std::string& in)
+{
+  std::string s;
+
+  for (char c : in)
+    {
+      switch (c)
+        {
+          case '<':  s += "&lt;"; break;
+          case '>':  s += "&gt;"; break;
+          case '&':  s += "&amp;"; break;
+          case '"':  s += "&quot;"; break;
+          case '\n': s += "&#xA;"; break;
+          default:   s += c;
+        }
+    }
+
+  return s;
+}
+
+static void
+write_schema_prologue(std::ostream& s, unsigned int num_of_classes)
+{
+  s <<
+    "<?xml version=\"1.0\" encoding=\"ASCII\"?>\n"
+    "\n"
+    "<!-- oks-schema version 2.2 -->\n"
+    "\n"
+    "\n"
+    "<!DOCTYPE oks-schema [\n"
+    "  <!ELEMENT oks-schema (info, (include)?, (comments)?, (class)+)>\n"
+    "  <!ELEMENT info EMPTY>\n"
+    "  <!ATTLIST info\n"
+    "      name CDATA #IMPLIED\n"
+    "      type CDATA #IMPLIED\n"
+    "      num-of-items CDATA #REQUIRED\n"
+    "      oks-format CDATA #FIXED \"schema\"\n"
+    "      oks-version CDATA #REQUIRED\n"
+    "      created-by CDATA #IMPLIED\n"
+    "      created-on CDATA #IMPLIED\n"
+    "      creation-time CDATA #IMPLIED\n"
+    "      last-modified-by CDATA #IMPLIED\n"
+    "      last-modified-on CDATA #IMPLIED\n"
+    "      last-modification-time CDATA #IMPLIED\n"
+    "  >\n"
+    "  <!ELEMENT include (file)+>\n"
+    "  <!ELEMENT file EMPTY>\n"
+    "  <!ATTLIST file\n"
+    "      path CDATA #REQUIRED\n"
+    "  >\n"
+    "  <!ELEMENT comments (comment)+>\n"
+    "  <!ELEMENT comment EMPTY>\n"
+    "  <!ATTLIST comment\n"
+    "      creation-time CDATA #REQUIRED\n"
+    "      created-by CDATA #REQUIRED\n"
+    "      created-on CDATA #REQUIRED\n"
+    "      author CDATA #REQUIRED\n"
+    "      text CDATA #REQUIRED\n"
+    "  >\n"
+    "  <!ELEMENT class (superclass | attribute | relationship | method)*>\n"
+    "  <!ATTLIST class\n"
+    "      name CDATA #REQUIRED\n"
+    "      description CDATA \"\"\n"
+    "      is-abstract (yes|no) \"no\"\n"
+    "  >\n"
+    "  <!ELEMENT superclass EMPTY>\n"
+    "  <!ATTLIST superclass name CDATA #REQUIRED>\n"
+    "  <!ELEMENT attribute EMPTY>\n"
+    "  <!ATTLIST attribute\n"
+    "      name CDATA #REQUIRED\n"
+    "      description CDATA \"\"\n"
+    "      type (bool|s8|u8|s16|u16|s32|u32|s64|u64|float|double|date|time|string|uid|enum|class) #REQUIRED\n"
+    "      range CDATA \"\"\n"
+    "      format (dec|hex|oct) \"dec\"\n"
+    "      is-multi-value (yes|no) \"no\"\n"
+    "      init-value CDATA \"\"\n"
+    "      is-not-null (yes|no) \"no\"\n"
+    "  >\n"
+    "  <!ELEMENT relationship EMPTY>\n"
+    "  <!ATTLIST relationship\n"
+    "      name CDATA #REQUIRED\n"
+    "      description CDATA \"\"\n"
+    "      class-type CDATA #REQUIRED\n"
+    "      low-cc (zero|one) #REQUIRED\n"
+    "      high-cc (one|many) #REQUIRED\n"
+    "      is-composite (yes|no) #REQUIRED\n"
+    "      is-exclusive (yes|no) #REQUIRED\n"
+    "      is-dependent (yes|no) #REQUIRED\n"
+    "  >\n"
+    "  <!ELEMENT method (method-implementation*)>\n"
+    "  <!ATTLIST method\n"
+    "      name CDATA #REQUIRED\n"
+    "      description CDATA \"\"\n"
+    "  >\n"
+    "  <!ELEMENT method-implementation EMPTY>\n"
+    "  <!ATTLIST method-implementation\n"
+    "      language CDATA #REQUIRED\n"
+    "      prototype CDATA #REQUIRED\n"
+    "      body CDATA \"\"\n"
+    "  >\n"
+    "]>\n"
+    "\n"
+    "<oks-schema>\n"
+    "\n"
+    "<info name=\"\" type=\"\" num-of-items=\"" << num_of_classes << "\" oks-format=\"schema\" oks-version=\"oksdalgen_benchmark\" "
+    "created-by=\"oksdalgen_benchmark\" created-on=\"localhost\" creation-time=\"20240101T000000\" "
+    "last-modified-by=\"oksdalgen_benchmark\" last-modified-on=\"localhost\" last-modification-time=\"20240101T000000\"/>\n"
+    "\n";
+}
+
+static void
+write_schema_epilogue(std::ostream& s)
+{
+  s << "</oks-schema>\n";
+}
+
+static std::string
+class_name(unsigned int idx)
+{
+  return "Class" + std::to_string(idx);
+}
+
+static std::string
+external_class_name(unsigned int dir, unsigned int idx)
+{
+  return "External" + std::to_string(dir) + "_" + std::to_string(idx);
+}
+
+static void
+write_class(std::ostream& s, unsigned int idx, const Parameters& p)
+{
+  static const struct { const char * type; const char * format; const char * range; const char * init; bool multi; } types[] = {
+    { "bool", "dec", "", "0", false },
+    { "u8", "hex", "", "0", false },
+    { "s32", "dec", "", "0", false },
+    { "u32", "hex", "", "0", false },
+    { "s64", "dec", "", "0", false },
+    { "double", "dec", "", "0", false },
+    { "string", "dec", "", "", false },
+    { "enum", "dec", "Low,Medium,High", "Low", false },
+    { "u16", "oct", "", "0", false },
+    { "string", "dec", "", "", true },
+    { "u32", "dec", "", "", true }
+  };
+
+  const std::string name(class_name(idx));
+
+  s << "<class name=\"" << name << "\" description=\"Synthetic class " << idx << "\" is-abstract=\"no\">\n";
+
+  // classes build chains of superclasses; the root of each chain inherits from an external class if any
+
+  if (idx % p.m_inheritance_depth != 0)
+    s << " <superclass name=\"" << class_name(idx - 1) << "\"/>\n";
+  else if (p.m_external_dirs && p.m_external_classes)
+    s << " <superclass name=\"" << external_class_name(idx % p.m_external_dirs, idx % p.m_external_classes) << "\"/>\n";
+
+  for (unsigned int i = 0; i < p.m_attributes; ++i)
+    {
+      const auto& t = types[i % (sizeof(types) / sizeof(types[0]))];
+      s << " <attribute name=\"c" << idx << "a" << i << "\" description=\"Attribute " << i << "\" type=\"" << t.type << "\" range=\"" << t.range
+        << "\" format=\"" << t.format << "\" is-multi-value=\"" << (t.multi ? "yes" : "no") << "\" init-value=\"" << t.init << "\" is-not-null=\"no\"/>\n";
+    }
+
+  for (unsigned int i = 0; i < p.m_relationships; ++i)
+    {
+      std::string type;
+
+      if (p.m_external_dirs && p.m_external_classes && i % 4 == 3)
+        type = external_class_name((idx + i) % p.m_external_dirs, (idx * 3 + i) % p.m_external_classes);
+      else
+        type = class_name((idx * 7 + i * 13 + 1) % p.m_classes);
+
+      s << " <relationship name=\"c" << idx << "r" << i << "\" description=\"Relationship " << i << "\" class-type=\"" << type
+        << "\" low-cc=\"" << (i % 3 == 0 ? "one" : "zero") << "\" high-cc=\"" << (i % 2 ? "many" : "one")
+        << "\" is-composite=\"" << (i % 5 == 4 ? "yes" : "no") << "\" is-exclusive=\"no\" is-dependent=\"no\"/>\n";
+    }
+
+  for (unsigned int i = 0; i < p.m_methods; ++i)
+    {
+      const std::string rtype(class_name((idx * 11 + i * 5 + 3) % p.m_classes));
+      const std::string atype(class_name((idx * 17 + i * 3 + 2) % p.m_classes));
+
+      std::string prototype, body;
+
+      if (i % 2)
+        {
+          prototype = "virtual const " + rtype + " * c" + std::to_string(idx) + "m" + std::to_string(i) + "(const " + atype + "& obj) const";
+          body = "ADD_ALGO_1\n  (void)obj;\n  return nullptr;";
+        }
+      else
+        {
+          prototype = "std::vector<const " + rtype + "*> c" + std::to_string(idx) + "m" + std::to_string(i) + "() const";
+          body = "ADD_ALGO_N\n  return {};";
+        }
+
+      s << " <method name=\"c" << idx << "m" << i << "\" description=\"Method " << i << "\">\n"
+           "  <method-implementation language=\"c++\" prototype=\"" << xml_attr(prototype) << "\" body=\"" << xml_attr(body) << "\"/>\n"
+           " </method>\n";
+    }
+
+  s << "</class>\n\n";
+}
+
+static void
+write_file(const std::string& file_name, const std::string& data)
+{
+  std::ofstream f(file_name.c_str());
+
+  if (!f || !(f << data) || !f.flush())
+    {
+      std::cerr << "ERROR: can not create file \"" << file_name << "\"\n";
+      exit(EXIT_FAILURE);
+    }
+}
+
+static void
+make_dir(const std::string& dir_name)
+{
+  if (mkdir(dir_name.c_str(), 0755) != 0 && errno != EEXIST)
+    {
+      std::cerr << "ERROR: can not create directory \"" << dir_name << "\": " << strerror(errno) << std::endl;
+      exit(EXIT_FAILURE);
+    }
+}
+
+static void
+synthesize_schemas(const Parameters& p, std::list<std::string>& file_names, std::list<std::string>& include_dirs)
+{
+  make_dir(p.m_work_dir);
+
+  // external schemas are described by oksdalgen.info files in include directories
+
+  for (unsigned int d = 0; d < p.m_external_dirs; ++d)
+    {
+      const std::string dir(p.m_work_dir + "/external" + std::to_string(d));
+      make_dir(dir);
+
+      std::ostringstream schema, info;
+
+      write_schema_prologue(schema, p.m_external_classes);
+
+      info <<
+        "// the file is generated by oksdalgen_benchmark utility\n"
+        "c++-namespace=external" << d << "\n"
+        "c++-header-dir-prefix=external" << d << "\n"
+        "classes:\n";
+
+      for (unsigned int i = 0; i < p.m_external_classes; ++i)
+        {
+          schema << "<class name=\"" << external_class_name(d, i) << "\" description=\"\" is-abstract=\"no\">\n"
+                    " <attribute name=\"e" << d << "_" << i << "\" description=\"\" type=\"u32\" range=\"\" format=\"dec\" is-multi-value=\"no\" init-value=\"0\" is-not-null=\"no\"/>\n"
+                    "</class>\n\n";
+          info << "  " << external_class_name(d, i) << std::endl;
+        }
+
+      write_schema_epilogue(schema);
+
+      const std::string schema_name(dir + "/external" + std::to_string(d) + ".schema.xml");
+      write_file(schema_name, schema.str());
+      write_file(dir + "/oksdalgen.info", info.str());
+
+      file_names.push_back(schema_name);
+      include_dirs.push_back(dir);
+    }
+
+  std::ostringstream schema;
+
+  write_schema_prologue(schema, p.m_classes);
+
+  for (unsigned int i = 0; i < p.m_classes; ++i)
+    write_class(schema, i, p);
+
+  write_schema_epilogue(schema);
+
+  const std::string schema_name(p.m_work_dir + "/benchmark.schema.xml");
+  write_file(schema_name, schema.str());
+  file_names.push_back(schema_name);
+}
+
+
+  /**
+   *  The Phase keeps durations of repeated measurements of one generation phase
+   *  and amount of produced output.
+   */
+
+struct Phase
+{
+  const char * m_name;
+  std::vector<double> m_times = {};
+  std::size_t m_bytes = 0;
+
+  void
+  measure(const std::function<void()>& f)
+  {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    m_times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+  }
+
+  void
+  print(std::ostream& s) const
+  {
+    std::vector<double> v(m_times);
+    std::sort(v.begin(), v.end());
+
+    s << "    \"" << m_name << "\": { "
+         "\"min_ms\": " << v.front() << ", "
+         "\"median_ms\": " << v[v.size() / 2] << ", "
+         "\"mean_ms\": " << std::accumulate(v.begin(), v.end(), 0.0) / v.size() << ", "
+         "\"max_ms\": " << v.back() << ", "
+         "\"bytes\": " << m_bytes << " }";
+  }
+};
+
+
+int
+main(int argc, char *argv[])
+{
+  Parameters p;
+
+  for (int i = 1; i < argc; i++)
+    {
+      const char * cp = argv[i];
+
+      if (!strcmp(cp, "-h") || !strcmp(cp, "--help"))
+        {
+          usage();
+          return EXIT_SUCCESS;
+        }
+      else if (!strcmp(cp, "-w") || !strcmp(cp, "--work-dir"))
+        {
+          if (++i == argc || argv[i][0] == '-')
+            no_param(cp);
+          else
+            p.m_work_dir = argv[i];
+        }
+      else if (!strcmp(cp, "-o") || !strcmp(cp, "--out-file"))
+        {
+          if (++i == argc || argv[i][0] == '-')
+            no_param(cp);
+          else
+            p.m_out_file = argv[i];
+        }
+      else
+        {
+          unsigned int * value = (
+            (!strcmp(cp, "-c") || !strcmp(cp, "--classes"))           ? &p.m_classes :
+            (!strcmp(cp, "-a") || !strcmp(cp, "--attributes"))        ? &p.m_attributes :
+            (!strcmp(cp, "-r") || !strcmp(cp, "--relationships"))     ? &p.m_relationships :
+            (!strcmp(cp, "-l") || !strcmp(cp, "--inheritance-depth")) ? &p.m_inheritance_depth :
+            (!strcmp(cp, "-m") || !strcmp(cp, "--methods"))           ? &p.m_methods :
+            (!strcmp(cp, "-e") || !strcmp(cp, "--external-dirs"))     ? &p.m_external_dirs :
+            (!strcmp(cp, "-x") || !strcmp(cp, "--external-classes"))  ? &p.m_external_classes :
+            (!strcmp(cp, "-n") || !strcmp(cp, "--repeat"))            ? &p.m_repeat :
+            nullptr
+          );
+
+          if (value == nullptr)
+            {
+              std::cerr << "ERROR: Unexpected parameter: \"" << cp << "\"\n\n";
+              usage();
+              return EXIT_FAILURE;
+            }
+
+          if (++i == argc || argv[i][0] == '-')
+            no_param(cp);
+
+          char * end;
+          errno = 0;
+          unsigned long v = strtoul(argv[i], &end, 10);
+          if (end == argv[i] || *end != 0 || errno != 0 || v > std::numeric_limits<unsigned int>::max())
+            {
+              std::cerr << "ERROR: bad value \"" << argv[i] << "\" for option \'" << cp << "\', expected non-negative number\n\n";
+              return EXIT_FAILURE;
+            }
+
+          *value = v;
+        }
+    }
+
+  if (p.m_classes == 0 || p.m_inheritance_depth == 0 || p.m_repeat == 0)
+    {
+      std::cerr << "ERROR: number of classes, inheritance depth and number of repetitions have to be positive\n";
+      return EXIT_FAILURE;
+    }
+
+  std::list<std::string> file_names;
+  std::list<std::string> include_dirs;
+  const std::list<std::string> user_classes;
+  const std::string cpp_ns_name("benchmark");
+  const std::string cpp_hdr_dir("benchmark");
+  const GenerationOptions options;
+
+  synthesize_schemas(p, file_names, include_dirs);
+
+  Phase load{"load_schemas"}, external{"process_external_class"}, names{"build_class_names_index"}, header{"gen_header"}, body{"gen_cpp_body"}, dump{"gen_dump_application"}, info{"write_info_file"};
+
+  try
+    {
+      for (unsigned int r = 0; r < p.m_repeat; ++r)
+        {
+          oks::OksKernel kernel(false, false, false, false);
+          std::set<oks::OksFile *, std::less<oks::OksFile *> > file_hs;
+
+          load.measure([&]() { load_schemas(kernel, file_names, file_hs); });
+
+          std::set<const oks::OksClass *, std::less<const oks::OksClass *> > generated_classes;
+          std::list<std::string> class_names;
+
+          for (unsigned int i = 0; i < p.m_classes; ++i)
+            if (const oks::OksClass * c = kernel.find_class(class_name(i)))
+              {
+                generated_classes.insert(c);
+                class_names.push_back(c->get_name());
+              }
+
+          ClassInfo::Map cl_info;
+
+          external.measure([&]()
+            {
+              ExternalClassIndex index;
+              build_external_class_index(index, include_dirs, user_classes, false);
+
+              for (const auto& c : generated_classes)
+                {
+                  if (const std::list<oks::OksRelationship *> * rels = c->direct_relationships())
+                    for (const auto& j : *rels)
+                      if (generated_classes.find(j->get_class_type()) == generated_classes.end())
+                        process_external_class(cl_info, j->get_class_type(), index, false);
+
+                  if (const std::list<std::string *> * sclasses = c->direct_super_classes())
+                    for (const auto& j : *sclasses)
+                      {
+                        const oks::OksClass * sc = kernel.find_class(*j);
+                        if (generated_classes.find(sc) == generated_classes.end())
+                          process_external_class(cl_info, sc, index, false);
+                      }
+                }
+            });
+
+          ClassNamesIndex cl_names;
+
+          names.measure([&]() { build_class_names_index(kernel, cl_names); });
+
+          std::ostringstream out;
+
+          header.measure([&]() { for (const auto& c : generated_classes) gen_header(c, out, cpp_ns_name, cpp_hdr_dir, cl_info, cl_names, options); });
+          header.m_bytes = out.tellp();
+
+          out.str("");
+          body.measure([&]() { for (const auto& c : generated_classes) gen_cpp_body(c, out, cpp_ns_name, cpp_hdr_dir, cl_info, options); });
+          body.m_bytes = out.tellp();
+
+          out.str("");
+          dump.measure([&]() { gen_dump_application(out, class_names, get_derived_first(kernel, class_names), cpp_ns_name, cpp_hdr_dir, "conffwk/Configuration.hpp", nullptr, "", "", options); });
+          dump.m_bytes = out.tellp();
+
+          out.str("");
+          info.measure([&]() { write_info_file(out, cpp_ns_name, cpp_hdr_dir, generated_classes); });
+          info.m_bytes = out.tellp();
+        }
+    }
+  catch (oks::exception & ex)
+    {
+      std::cerr << "Caught oks exception:\n" << ex << std::endl;
+      return (EXIT_FAILURE);
+    }
+  catch (std::exception & e)
+    {
+      std::cerr << "Caught standard C++ exception: " << e.what() << std::endl;
+      return (EXIT_FAILURE);
+    }
+
+  std::ostringstream s;
+
+  s << "{\n"
+       "  \"parameters\": { "
+       "\"classes\": " << p.m_classes << ", "
+       "\"attributes\": " << p.m_attributes << ", "
+       "\"relationships\": " << p.m_relationships << ", "
+       "\"inheritance_depth\": " << p.m_inheritance_depth << ", "
+       "\"methods\": " << p.m_methods << ", "
+       "\"external_dirs\": " << p.m_external_dirs << ", "
+       "\"external_classes\": " << p.m_external_classes << ", "
+       "\"repeat\": " << p.m_repeat << " },\n"
+       "  \"phases\": {\n";
+
+  bool is_first = true;
+  for (const Phase * x : { &load, &external, &names, &header, &body, &dump, &info })
+    {
+      if (is_first)
+        is_first = false;
+      else
+        s << ",\n";
+      x->print(s);
+    }
+
+  s << "\n  }\n}\n";
+
+  if (p.m_out_file.empty())
+    std::cout << s.str();
+  else
+    write_file(p.m_out_file, s.str());
+
+  return EXIT_SUCCESS;
+}
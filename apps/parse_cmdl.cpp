@@ -1,7 +1,13 @@
+#include "class_info.hpp"
+
+#include <cerrno>
+#include <climits>
 #include <cstdlib>
 #include <cstring>
 
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <list>
 
@@ -17,6 +23,26 @@ usage()
     "                 [-c | --classes class*]\n"
     "                 [-D | --user-defined-classes [namespace::]user-class[@dir-prefix]*]\n"
     "                 [-f | --info-file-name file-name]\n"
+    "                 [-j | --jobs number]\n"
+    "                 [-u | --incremental]\n"
+    "                 [--unity number]\n"
+    "                 [--stats[=file-name]]\n"
+    "                 [--trace file-name]\n"
+    "                 [--typed-enums]\n"
+    "                 [--chrono-dates]\n"
+    "                 [--compact-layout]\n"
+    "                 [--layout-report file-name]\n"
+    "                 [--size-budget file-name]\n"
+    "                 [--reflection]\n"
+    "                 [--snapshot]\n"
+    "                 [--json]\n"
+    "                 [--lazy-relationships]\n"
+    "                 [--lazy-attributes class*]\n"
+    "                 [--preload]\n"
+    "                 [--prelude]\n"
+    "                 [--fwd-header]\n"
+    "                 [--include-report file-name]\n"
+    "                 [--extern-templates]\n"
     "                 [-v | --verbose]\n"
     "                 [-h | --help]\n"
     "                 -s | --schema-files file.schema.xml+\n"
@@ -29,6 +55,36 @@ usage()
     "       -c class*            explicit list of classes to be generated\n"
     "       -D [x::]c[@d]*       user-defined classes\n"
     "       -f filename          name of output file describing generated files\n"
+    "       -j number            number of threads used to generate classes (default 1, at most 256)\n"
+    "       -u                   incremental mode: skip classes not changed since previous run\n"
+    "                            (their fingerprints are stored in the info-file-name.manifest)\n"
+    "       --unity number       also generate unity_<namespace>_<n>.cpp files including implementations of up to\n"
+    "                            given number of classes (at most 10000); the classes with common base are put into the same file\n"
+    "       --stats[=filename]   print (or write into file) time spent in generation phases and classes in JSON format\n"
+    "       --trace filename     write generation phases and classes timing in Chrome trace format\n"
+    "       --typed-enums        store single-value enumeration attributes as enum class; get_<name>_enum() and set_<name>(Enum)\n"
+    "                            are added and init() reports unexpected values of such attributes\n"
+    "       --chrono-dates       store date and time attributes as std::chrono::sys_days and sys_seconds (requires C++20)\n"
+    "       --compact-layout     order data members by alignment and pack bool attributes into bitfields\n"
+    "       --layout-report file\n"
+    "                            write c++ program printing sizeof() of generated classes and size of their data members\n"
+    "                            in schema and in generated order in JSON format\n"
+    "       --size-budget file   file with \"class-name max-size\" lines; generate static_assert checking sizeof() of these classes\n"
+    "       --reflection         generate constexpr descriptors of attributes and relationships for template-based visitors\n"
+    "       --snapshot           generate writer and loader of binary snapshot of data of objects; the loader sets data of\n"
+    "                            objects of loaded database instead of reading them; the dump application can write it\n"
+    "       --json               generate methods writing objects in JSON format; the dump application gets --format json\n"
+    "       --lazy-relationships resolve relationships on first access and cache them until the object is cleared\n"
+    "       --lazy-attributes class*\n"
+    "                            decode attributes of given classes on first access instead of init()\n"
+    "       --preload            generate preload_<namespace>() initializing all objects of generated classes by several threads\n"
+    "       --prelude            generate prelude_<namespace>.hpp with headers used by all classes, <namespace>.hpp including\n"
+    "                            all classes and prelude_<namespace>.pch listing headers to be precompiled\n"
+    "       --fwd-header         generate <namespace>_fwd.hpp with forward declarations of all classes for code using them\n"
+    "                            by pointers; generated class headers use it for classes of relationships and algorithms\n"
+    "       --include-report file\n"
+    "                            write size of include closure of generated headers and of forward declarations header in JSON format\n"
+    "       --extern-templates   declare conffwk templates for generated classes as extern and instantiate them in the class implementation files\n"
     "       -v                   switch on verbose output\n"
     "       -h                   this message\n"
     "       -s files+            the schema files (at least one is mandatory)\n"
@@ -44,6 +100,66 @@ no_param(const char * s)
   exit(EXIT_FAILURE);
 }
 
+  /**
+   *  The function get_number() returns positive number given for the option.
+   *  Bad values are reported; values above max_value are reduced to it.
+   */
+
+static unsigned int
+get_number(const char * option, const char * value, unsigned int max_value)
+{
+  char * end;
+  errno = 0;
+  unsigned long number = strtoul(value, &end, 10);
+
+  if (*end != 0 || number == 0 || errno == ERANGE || number > UINT_MAX)
+    {
+      std::cerr << "ERROR: bad value \"" << value << "\" for option \'" << option << "\', expected positive number\n\n";
+      exit(EXIT_FAILURE);
+    }
+
+  return (number > max_value ? max_value : number);
+}
+
+static void
+read_size_budget(const char * file_name, std::map<std::string, unsigned long>& budget)
+{
+  std::ifstream f(file_name);
+
+  if (!f)
+    {
+      std::cerr << "ERROR: can not open file \"" << file_name << "\"\n";
+      exit(EXIT_FAILURE);
+    }
+
+  std::string line;
+  unsigned int line_num = 0;
+
+  while (std::getline(f, line))
+    {
+      line_num++;
+
+      std::string::size_type idx = line.find('#');
+      if (idx != std::string::npos)
+        line.erase(idx);
+
+      std::istringstream s(line);
+      std::string class_name;
+      unsigned long size;
+
+      if (!(s >> class_name))
+        continue;
+
+      if (!(s >> size))
+        {
+          std::cerr << "ERROR: bad line " << line_num << " in file \"" << file_name << "\", expected \"class-name max-size\"\n";
+          exit(EXIT_FAILURE);
+        }
+
+      budget[class_name] = size;
+    }
+}
+
 void
 parse_arguments(int argc, char *argv[], 
                 std::list<std::string>& class_names, 
@@ -54,6 +170,14 @@ parse_arguments(int argc, char *argv[],
                 std::string& cpp_ns_name,
                 std::string& cpp_hdr_dir,
             		std::string& info_file_name,
+                unsigned int& jobs,
+                bool& incremental,
+                unsigned int& unity,
+                std::string& stats_file_name,
+                std::string& trace_file_name,
+                std::string& layout_report_file_name,
+                std::string& include_report_file_name,
+                dunedaq::oksdalgen::GenerationOptions& options,
 		            bool& verbose
               )
 {
@@ -71,6 +195,97 @@ parse_arguments(int argc, char *argv[],
         {
           verbose = true;
         }
+      else if (!strcmp(cp, "-u") || !strcmp(cp, "--incremental"))
+        {
+          incremental = true;
+        }
+      else if (!strncmp(cp, "--stats", 7) && (cp[7] == 0 || cp[7] == '='))
+        {
+          stats_file_name = (cp[7] == 0 ? "-" : cp + 8);
+
+          if (stats_file_name.empty())
+            no_param(cp);
+        }
+      else if (!strcmp(cp, "--typed-enums"))
+        {
+          options.m_typed_enums = true;
+        }
+      else if (!strcmp(cp, "--chrono-dates"))
+        {
+          options.m_chrono_dates = true;
+        }
+      else if (!strcmp(cp, "--compact-layout"))
+        {
+          options.m_compact_layout = true;
+        }
+      else if (!strcmp(cp, "--reflection"))
+        {
+          options.m_reflection = true;
+        }
+      else if (!strcmp(cp, "--snapshot"))
+        {
+          options.m_snapshot = true;
+        }
+      else if (!strcmp(cp, "--json"))
+        {
+          options.m_json = true;
+        }
+      else if (!strcmp(cp, "--lazy-relationships"))
+        {
+          options.m_lazy_relationships = true;
+        }
+      else if (!strcmp(cp, "--preload"))
+        {
+          options.m_preload = true;
+        }
+      else if (!strcmp(cp, "--prelude"))
+        {
+          options.m_prelude = true;
+        }
+      else if (!strcmp(cp, "--fwd-header"))
+        {
+          options.m_fwd_header = true;
+        }
+      else if (!strcmp(cp, "--extern-templates"))
+        {
+          options.m_extern_templates = true;
+        }
+      else if (!strcmp(cp, "--lazy-attributes"))
+        {
+          if (i + 1 == argc || argv[i + 1][0] == '-')
+            no_param(cp);
+
+          while (i + 1 < argc && argv[i + 1][0] != '-')
+            options.m_lazy_attributes.insert(argv[++i]);
+        }
+      else if (!strcmp(cp, "--layout-report"))
+        {
+          if (++i == argc || argv[i][0] == '-')
+            no_param(cp);
+          else
+            layout_report_file_name = argv[i];
+        }
+      else if (!strcmp(cp, "--include-report"))
+        {
+          if (++i == argc || argv[i][0] == '-')
+            no_param(cp);
+          else
+            include_report_file_name = argv[i];
+        }
+      else if (!strcmp(cp, "--size-budget"))
+        {
+          if (++i == argc || argv[i][0] == '-')
+            no_param(cp);
+          else
+            read_size_budget(argv[i], options.m_size_budget);
+        }
+      else if (!strcmp(cp, "--trace"))
+        {
+          if (++i == argc || argv[i][0] == '-')
+            no_param(cp);
+          else
+            trace_file_name = argv[i];
+        }
       else if (!strcmp(cp, "-d") || !strcmp(cp, "--c++-dir-name"))
         {
           if (++i == argc || argv[i][0] == '-')
@@ -99,6 +314,20 @@ parse_arguments(int argc, char *argv[],
           else
             info_file_name = argv[i];
         }
+      else if (!strcmp(cp, "-j") || !strcmp(cp, "--jobs"))
+        {
+          if (++i == argc || argv[i][0] == '-')
+            no_param(cp);
+          else
+            jobs = get_number(cp, argv[i], 256);
+        }
+      else if (!strcmp(cp, "--unity"))
+        {
+          if (++i == argc || argv[i][0] == '-')
+            no_param(cp);
+          else
+            unity = get_number(cp, argv[i], 10000);
+        }
       else
         {
           std::list<std::string> * slist = (
@@ -144,6 +373,9 @@ parse_arguments(int argc, char *argv[],
           "    c++ directory name:    \"" << cpp_dir_name << "\"\n"
           "    c++ namespace name:    \"" << cpp_ns_name << "\"\n"
           "    c++ headers directory: \"" << cpp_hdr_dir << "\"\n"
+          "    generation jobs:       " << jobs << "\n"
+          "    incremental mode:      " << (incremental ? "yes" : "no") << "\n"
+          "    generation options:   " << (options.str().empty() ? " none" : options.str()) << "\n"
           "    classes:";
 
       if (!class_names.empty())
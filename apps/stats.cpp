@@ -0,0 +1,136 @@
+#include "stats.hpp"
+
+#include <sys/resource.h>
+#include <time.h>
+
+#include <algorithm>
+#include <map>
+
+using namespace dunedaq::oksdalgen;
+
+
+static double
+get_cpu_time(bool per_thread)
+{
+  struct timespec ts;
+  clock_gettime(per_thread ? CLOCK_THREAD_CPUTIME_ID : CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+Stats::Timer::Timer(Stats * stats, const char * name, const std::string& class_name, unsigned int thread) :
+  m_stats(stats)
+{
+  if (m_stats)
+    {
+      m_record = Record{name, class_name, thread, 0, 0, 0, 0};
+      m_start = std::chrono::steady_clock::now();
+      m_cpu_start = get_cpu_time(!class_name.empty());
+    }
+}
+
+Stats::Timer::~Timer()
+{
+  if (m_stats)
+    {
+      auto stop = std::chrono::steady_clock::now();
+      m_record.m_start = std::chrono::duration<double, std::micro>(m_start - m_stats->m_start).count();
+      m_record.m_wall = std::chrono::duration<double, std::micro>(stop - m_start).count();
+      m_record.m_cpu = get_cpu_time(!m_record.m_class.empty()) - m_cpu_start;
+      m_stats->add(std::move(m_record));
+    }
+}
+
+void
+Stats::add(Record&& r)
+{
+  std::lock_guard scoped_lock(m_mutex);
+  m_records.push_back(std::move(r));
+}
+
+long
+Stats::get_peak_rss()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+static std::string
+json_string(const std::string& in)
+{
+  std::string s("\"");
+
+  for (char c : in)
+    {
+      if (c == '\"' || c == '\\')
+        s += '\\';
+      s += c;
+    }
+
+  return s += '\"';
+}
+
+void
+Stats::write_json(std::ostream& s) const
+{
+  std::lock_guard scoped_lock(m_mutex);
+
+  s << "{\n  \"phases\": [";
+
+  bool is_first = true;
+
+  for (const auto& r : m_records)
+    if (r.m_class.empty())
+      {
+        s << (is_first ? "\n" : ",\n") << "    { \"name\": " << json_string(r.m_name) << ", \"wall_ms\": " << r.m_wall / 1000 << ", \"cpu_ms\": " << r.m_cpu / 1000 << " }";
+        is_first = false;
+      }
+
+  // group records of classes by class name
+
+  std::map<std::string, std::vector<const Record *>> classes;
+
+  for (const auto& r : m_records)
+    if (!r.m_class.empty())
+      classes[r.m_class].push_back(&r);
+
+  s << "\n  ],\n  \"classes\": [";
+
+  is_first = true;
+
+  for (const auto& c : classes)
+    {
+      s << (is_first ? "\n" : ",\n") << "    { \"name\": " << json_string(c.first);
+
+      for (const auto& r : c.second)
+        s << ", \"" << r->m_name << "\": { \"wall_ms\": " << r->m_wall / 1000 << ", \"cpu_ms\": " << r->m_cpu / 1000 << ", \"bytes\": " << r->m_bytes << " }";
+
+      s << " }";
+      is_first = false;
+    }
+
+  s << "\n  ],\n  \"peak_rss_kb\": " << get_peak_rss() << "\n}\n";
+}
+
+void
+Stats::write_trace(std::ostream& s) const
+{
+  std::lock_guard scoped_lock(m_mutex);
+
+  s << "{\"traceEvents\":[";
+
+  bool is_first = true;
+
+  for (const auto& r : m_records)
+    {
+      s << (is_first ? "\n" : ",\n")
+        << "{\"name\":" << json_string(r.m_class.empty() ? r.m_name : r.m_class + ' ' + r.m_name)
+        << ",\"cat\":\"" << (r.m_class.empty() ? "phase" : "class") << "\",\"ph\":\"X\""
+        << ",\"ts\":" << static_cast<long long>(r.m_start) << ",\"dur\":" << static_cast<long long>(r.m_wall)
+        << ",\"pid\":1,\"tid\":" << r.m_thread
+        << ",\"args\":{\"cpu_us\":" << static_cast<long long>(r.m_cpu) << ",\"bytes\":" << r.m_bytes << "}}";
+      is_first = false;
+    }
+
+  s << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
@@ -0,0 +1,78 @@
+#ifndef __OKSDALGEN_STATS__
+#define __OKSDALGEN_STATS__
+
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace dunedaq {
+namespace oksdalgen {
+
+  /**
+   *  The Stats collects wall and CPU time spent in phases of the generator
+   *  and in generation of individual classes. The results can be written
+   *  in JSON format or as Chrome trace events.
+   */
+
+class Stats {
+
+  public:
+
+    struct Record {
+      std::string m_name;      // name of phase, e.g. "load_schemas" or "gen_header"
+      std::string m_class;     // name of generated class, if any
+      unsigned int m_thread;   // index of generation thread
+      double m_start;          // start time since creation of stats [us]
+      double m_wall;           // wall time [us]
+      double m_cpu;            // CPU time of process (phases) or of thread (classes) [us]
+      std::size_t m_bytes;     // size of generated code, if any
+    };
+
+
+      /**
+       *  The Timer measures time of the phase or of the class generation
+       *  between its construction and destruction. It does nothing,
+       *  if the stats pointer is null.
+       */
+
+    class Timer {
+
+      public:
+
+        Timer(Stats * stats, const char * name, const std::string& class_name = "", unsigned int thread = 0);
+        ~Timer();
+
+        void set_bytes(std::size_t bytes) { m_record.m_bytes = bytes; }
+
+      private:
+
+        Stats * m_stats;
+        Record m_record;
+        std::chrono::steady_clock::time_point m_start;
+        double m_cpu_start;
+    };
+
+
+    Stats() : m_start(std::chrono::steady_clock::now()) {};
+
+    void add(Record&& r);
+
+    void write_json(std::ostream& s) const;
+    void write_trace(std::ostream& s) const;
+
+    static long get_peak_rss();
+
+
+  private:
+
+    std::chrono::steady_clock::time_point m_start;
+    mutable std::mutex m_mutex;
+    std::vector<Record> m_records;
+
+};
+
+} // namespace oksdalgen
+} // namespace dunedaq
+#endif
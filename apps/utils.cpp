@@ -7,15 +7,24 @@
 #include <ctype.h>
 
 #include <algorithm>
+#include <chrono>
 #include <ctime>
 #include <initializer_list>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <sstream>
 
 
 using namespace dunedaq::oks;
 using namespace dunedaq::oksdalgen;
 
+  // declare functions defined below
+
+extern std::string int2dx(int level);
+extern int open_cpp_namespace(std::ostream& s, const std::string& value);
+extern void close_cpp_namespace(std::ostream& s, int level);
+
   /**
    *  The functions cvt_symbol() and alnum_name() are used
    *  to replace all symbols allowed in names of classes, attributes
@@ -158,23 +167,63 @@ get_type(OksData::Type oks_type, bool is_cpp)
 //   return str;
 // }
 
+  /**
+   *  The function get_derived_first() returns names of generated classes ordered
+   *  so that each class precedes its superclasses. A class has more superclasses
+   *  than any of its superclasses, so the classes are sorted by their number;
+   *  the sort is stable and keeps the order of names otherwise.
+   */
+
+std::list<std::string>
+get_derived_first(const OksKernel& kernel, const std::list<std::string>& class_names)
+{
+  auto count = [&kernel](const std::string& name) -> std::size_t
+    {
+      const OksClass::FList * sclasses = kernel.find_class(name)->all_super_classes();
+      return (sclasses ? sclasses->size() : 0);
+    };
+
+  std::list<std::string> names(class_names);
+  names.sort([&count](const std::string& n1, const std::string& n2) { return count(n1) > count(n2); });
+  return names;
+}
+
 void
 gen_dump_application(std::ostream& s,
                      std::list<std::string>& class_names,
+                     const std::list<std::string>& derived_first_names,
 		     const std::string& cpp_ns_name,
 		     const std::string& cpp_hdr_dir,
 		     const char * conf_header,
 		     const char * conf_name,
 		     const char * headres_prologue,
-		     const char * main_function_prologue
+		     const char * main_function_prologue,
+		     const GenerationOptions& options
 		     )
 {
   s <<
     "  // *** this file is generated by oksdalgen ***\n"
     "\n"
+    "#include <sys/resource.h>\n"
+    "\n"
+    "#include <algorithm>\n"
+    "#include <atomic>\n"
+    "#include <chrono>\n"
+    "#include <exception>\n"
+    "#include <iomanip>\n"
+    "#include <map>\n"
+    "#include <mutex>\n"
+    "#include <sstream>\n"
+    "#include <thread>\n"
+    "#include <unordered_map>\n"
+    "#include <unordered_set>\n"
+    "\n"
     "#include \"conffwk/ConfigObject.hpp\"\n"
     "#include \"" << conf_header << "\"\n\n";
 
+  if (options.m_snapshot)
+    s << "#include <fstream>\n\n";
+
   // generate list of includes
   for (const auto& i : class_names)
     {
@@ -195,15 +244,34 @@ gen_dump_application(std::ostream& s,
       "\n"
       "static void usage(const char * s)\n"
       "{\n"
-      "  std::cout << s << \" -d db-name -c class-name [-q query | -i object-id] [-t]\\n\"\n"
+      "  std::cout << s << \" -d db-name (-c class-name [-q query | -i object-id] | -a) [-t] [-j number] [-R number] [-N] [-T]" << (options.m_json ? " [-f text|json]" : "") << (options.m_snapshot ? " [-r snapshot-file]\\n\"\n"
+      "       \"       \" << s << \" -d db-name -w snapshot-file [-t]" : "") << "\\n\"\n"
       "    \"\\n\"\n"
       "    \"Options/Arguments:\\n\"\n"
       "    \"  -d | --data db-name            mandatory name of the database\\n\"\n"
-      "    \"  -c | --class-name class-name   mandatory name of class\\n\"\n"
+      "    \"  -c | --class-name class-name   name of class (mandatory, if -a is not given)\\n\"\n"
+      "    \"  -a | --all                     dump all objects of generated classes and of their subclasses\\n\"\n"
       "    \"  -q | --query query             optional query to select class objects\\n\"\n"
       "    \"  -i | --object-id object-id     optional identity to select one object\\n\"\n"
       "    \"  -t | --init-children           all referenced objects are initialized (is used\\n\"\n"
       "    \"                                 for debug purposes and performance measurements)\\n\"\n"
+      "    \"  -j | --threads number          initialize and format objects by several threads\\n\"\n"
+      "    \"                                 (at most number of hardware threads)\\n\"\n"
+      "    \"  -R | --repeat number           repeat loading of database and objects given number of times\\n\"\n"
+      "    \"  -N | --no-print                do not print objects\\n\"\n"
+      "    \"  -T | --timing                  report time of loading phases per repeat and per class,\\n\"\n"
+      "    \"                                 and peak resident set size\\n\"\n";
+
+  if (options.m_json)
+    s <<
+      "    \"  -f | --format text|json        print objects as text (default) or as JSON array\\n\"\n";
+
+  if (options.m_snapshot)
+    s <<
+      "    \"  -w | --write-snapshot file     write binary snapshot of all objects of generated classes\\n\"\n"
+      "    \"  -r | --read-snapshot file      set data of objects from binary snapshot instead of reading them\\n\"\n";
+
+  s <<
       "    \"  -h | --help                    print this message\\n\"\n"
       "    \"\\n\"\n"
       "    \"Description:\\n\"\n"
@@ -219,6 +287,137 @@ gen_dump_application(std::ostream& s,
       "  exit (EXIT_FAILURE);\n"
       "}\n"
       "\n"
+      "  // time of loading phases in microseconds; vectors contain values of all repeats\n"
+      "\n"
+      "struct Timing {\n"
+      "  typedef std::chrono::steady_clock::time_point time_point;\n"
+      "\n"
+      "  struct Phases {\n"
+      "    std::vector<double> m_init;\n"
+      "    std::vector<double> m_print;\n"
+      "    unsigned long m_objects = 0;\n"
+      "  };\n"
+      "\n"
+      "  std::vector<double> m_open;\n"
+      "  std::vector<double> m_get;\n"
+      "  std::vector<double> m_init;\n"
+      "  std::vector<double> m_print;\n"
+      "  std::map<std::string, Phases> m_classes;\n"
+      "\n"
+      "  static double interval(time_point t1, time_point t2) {\n"
+      "    return std::chrono::duration<double, std::micro>(t2 - t1).count();\n"
+      "  }\n"
+      "\n"
+      "  void add_object(unsigned int repeat, const std::string& cl, time_point t1, time_point t2, time_point t3) {\n"
+      "    const double init = interval(t1, t2), print = interval(t2, t3);\n"
+      "    m_init.resize(repeat + 1);\n"
+      "    m_print.resize(repeat + 1);\n"
+      "    m_init[repeat] += init;\n"
+      "    m_print[repeat] += print;\n"
+      "    Phases& x = m_classes[cl];\n"
+      "    x.m_init.resize(repeat + 1);\n"
+      "    x.m_print.resize(repeat + 1);\n"
+      "    x.m_init[repeat] += init;\n"
+      "    x.m_print[repeat] += print;\n"
+      "    if(repeat == 0) x.m_objects++;\n"
+      "  }\n"
+      "\n"
+      "  void merge(unsigned int repeat, const Timing& t) {\n"
+      "    m_init.resize(repeat + 1);\n"
+      "    m_print.resize(repeat + 1);\n"
+      "    if(repeat < t.m_init.size()) {\n"
+      "      m_init[repeat] += t.m_init[repeat];\n"
+      "      m_print[repeat] += t.m_print[repeat];\n"
+      "    }\n"
+      "    for(const auto& x : t.m_classes) {\n"
+      "      Phases& y = m_classes[x.first];\n"
+      "      y.m_init.resize(repeat + 1);\n"
+      "      y.m_print.resize(repeat + 1);\n"
+      "      y.m_init[repeat] += x.second.m_init[repeat];\n"
+      "      y.m_print[repeat] += x.second.m_print[repeat];\n"
+      "      if(repeat == 0) y.m_objects += x.second.m_objects;\n"
+      "    }\n"
+      "  }\n"
+      "\n"
+      "  static void report(const char * name, std::vector<double> v, unsigned int repeats) {\n"
+      "    v.resize(repeats);\n"
+      "    std::sort(v.begin(), v.end());\n"
+      "    auto percentile = [&v](unsigned int p) { return v[(v.size() * p + 99) / 100 - 1]; };\n"
+      "    std::cout << \"  \" << std::left << std::setw(42) << name << std::right\n"
+      "              << std::setw(12) << v.front() << std::setw(12) << percentile(50) << std::setw(12) << percentile(90) << std::setw(12) << v.back() << std::endl;\n"
+      "  }\n"
+      "\n"
+      "  void report(unsigned int repeats, bool init_children) const {\n"
+      "    std::cout << std::fixed << std::setprecision(1)\n"
+      "              << \"timing of \" << repeats << \" repeat(s) in microseconds:\\n\"\n"
+      "              << \"  \" << std::setw(42) << \"\" << std::setw(12) << \"min\" << std::setw(12) << \"p50\" << std::setw(12) << \"p90\" << std::setw(12) << \"max\" << std::endl;\n"
+      "    report(\"open database\", m_open, repeats);\n"
+      "    report(\"get config objects\", m_get, repeats);\n"
+      "    report(init_children ? \"init objects (with -t)\" : \"init objects (without -t)\", m_init, repeats);\n"
+      "    report(\"print objects\", m_print, repeats);\n"
+      "    for(const auto& x : m_classes) {\n"
+      "      std::cout << \"  class \" << x.first << \" (\" << x.second.m_objects << \" objects):\\n\";\n"
+      "      report(\"  init\", x.second.m_init, repeats);\n"
+      "      report(\"  print\", x.second.m_print, repeats);\n"
+      "    }\n"
+      "    struct rusage usage;\n"
+      "    if(getrusage(RUSAGE_SELF, &usage) == 0)\n"
+      "      std::cout << \"peak RSS: \" << usage.ru_maxrss << \" kB\" << std::endl;\n"
+      "  }\n"
+      "};\n"
+      "\n"
+      "  // initialize object of class T and print it; return time when the initialization is completed\n"
+      "\n"
+      "typedef std::chrono::steady_clock::time_point (*DumpFunction)(dunedaq::conffwk::Configuration&, dunedaq::conffwk::ConfigObject&, bool, bool, std::ostream&" << (options.m_json ? ", bool, std::size_t, dunedaq::oksdalgen::JsonWriter&" : "") << ");\n"
+      "\n"
+      "template<class T>\n"
+      "  static std::chrono::steady_clock::time_point\n"
+      "  dump_object(dunedaq::conffwk::Configuration& conf, dunedaq::conffwk::ConfigObject& obj, bool init_children, bool print, std::ostream& out" << (options.m_json ? ", bool json_format, std::size_t index, dunedaq::oksdalgen::JsonWriter& json" : "") << ")\n"
+      "  {\n"
+      "    const T * x = conf.get<T>(obj, init_children);\n"
+      "    const auto t = std::chrono::steady_clock::now();\n"
+      "\n";
+
+  if (options.m_json)
+    s <<
+      "    if(print && json_format) {\n"
+      "      json.clear();\n"
+      "      x->write_json(json);\n"
+      "      out << (index ? \",\\n\" : \"\\n\") << json.str();\n"
+      "    }\n"
+      "    else if(print) {\n"
+      "      out << *x << std::endl;\n"
+      "    }\n";
+  else
+    s <<
+      "    if(print)\n"
+      "      out << *x << std::endl;\n";
+
+  s <<
+      "\n"
+      "    return t;\n"
+      "  }\n"
+      "\n"
+      "  // dump functions of generated classes\n"
+      "\n"
+      "static const std::unordered_map<std::string, DumpFunction> dump_functions {\n";
+
+  for (const auto& i : class_names)
+    s << "  { \"" << i << "\", &dump_object<" << (cpp_ns_name.empty() ? std::string() : cpp_ns_name + "::") << i << "> },\n";
+
+  s <<
+      "};\n"
+      "\n"
+      "  // generated classes, each one precedes its superclasses\n"
+      "\n"
+      "static const char * const derived_first_classes[] {\n";
+
+  for (const auto& i : derived_first_names)
+    s << "  \"" << i << "\",\n";
+
+  s <<
+      "};\n"
+      "\n"
       "int main(int argc, char *argv[])\n"
       "{\n";
 
@@ -235,6 +434,22 @@ gen_dump_application(std::ostream& s,
       "  const char * query = \"\";\n"
       "  std::string class_name;\n"
       "  bool init_children = false;\n"
+      "  bool dump_all = false;\n"
+      "  unsigned int threads_count = 1;\n"
+      "  unsigned int repeat_count = 1;\n"
+      "  bool no_print = false;\n"
+      "  bool timing = false;\n";
+
+  if (options.m_json)
+    s <<
+      "  bool json_format = false;\n";
+
+  if (options.m_snapshot)
+    s <<
+      "  const char * write_snapshot = nullptr;\n"
+      "  const char * read_snapshot = nullptr;\n";
+
+  s <<
       "\n"
       "  for(int i = 1; i < argc; i++) {\n"
       "    const char * cp = argv[i];\n"
@@ -245,6 +460,9 @@ gen_dump_application(std::ostream& s,
       "    if(!strcmp(cp, \"-t\") || !strcmp(cp, \"--init-children\")) {\n"
       "      init_children = true;\n"
       "    }\n"
+      "    else if(!strcmp(cp, \"-a\") || !strcmp(cp, \"--all\")) {\n"
+      "      dump_all = true;\n"
+      "    }\n"
       "    else if(!strcmp(cp, \"-d\") || !strcmp(cp, \"--data\")) {\n"
       "      if(++i == argc || argv[i][0] == '-') { no_param(cp); } else { db_name = argv[i]; }\n"
       "    }\n"
@@ -257,6 +475,55 @@ gen_dump_application(std::ostream& s,
       "    else if(!strcmp(cp, \"-q\") || !strcmp(cp, \"--query\")) {\n"
       "      if(++i == argc || argv[i][0] == '-') { no_param(cp); } else { query = argv[i]; }\n"
       "    }\n"
+      "    else if(!strcmp(cp, \"-j\") || !strcmp(cp, \"--threads\")) {\n"
+      "      if(++i == argc || argv[i][0] == '-') { no_param(cp); }\n"
+      "      char * end;\n"
+      "      const unsigned long value = strtoul(argv[i], &end, 10);\n"
+      "      if(*end != 0 || value == 0) {\n"
+      "        std::cerr << \"ERROR: bad value \" << argv[i] << \" of option \" << cp << \", expected positive number\\n\";\n"
+      "        return (EXIT_FAILURE);\n"
+      "      }\n"
+      "        // more threads do not make dump faster, but make blocks of objects formatted in memory bigger\n"
+      "      threads_count = static_cast<unsigned int>(std::min<unsigned long>(value, std::max(std::thread::hardware_concurrency(), 1U)));\n"
+      "    }\n"
+      "    else if(!strcmp(cp, \"-R\") || !strcmp(cp, \"--repeat\")) {\n"
+      "      if(++i == argc || argv[i][0] == '-') { no_param(cp); }\n"
+      "      char * end;\n"
+      "      repeat_count = strtoul(argv[i], &end, 10);\n"
+      "      if(*end != 0 || repeat_count == 0) {\n"
+      "        std::cerr << \"ERROR: bad value \" << argv[i] << \" of option \" << cp << \", expected positive number\\n\";\n"
+      "        return (EXIT_FAILURE);\n"
+      "      }\n"
+      "    }\n"
+      "    else if(!strcmp(cp, \"-N\") || !strcmp(cp, \"--no-print\")) {\n"
+      "      no_print = true;\n"
+      "    }\n"
+      "    else if(!strcmp(cp, \"-T\") || !strcmp(cp, \"--timing\")) {\n"
+      "      timing = true;\n"
+      "    }\n";
+
+  if (options.m_json)
+    s <<
+      "    else if(!strcmp(cp, \"-f\") || !strcmp(cp, \"--format\")) {\n"
+      "      if(++i == argc || argv[i][0] == '-') { no_param(cp); }\n"
+      "      else if(!strcmp(argv[i], \"json\")) { json_format = true; }\n"
+      "      else if(!strcmp(argv[i], \"text\")) { json_format = false; }\n"
+      "      else {\n"
+      "        std::cerr << \"ERROR: bad format \" << argv[i] << \", expected text or json\\n\";\n"
+      "        return (EXIT_FAILURE);\n"
+      "      }\n"
+      "    }\n";
+
+  if (options.m_snapshot)
+    s <<
+      "    else if(!strcmp(cp, \"-w\") || !strcmp(cp, \"--write-snapshot\")) {\n"
+      "      if(++i == argc || argv[i][0] == '-') { no_param(cp); } else { write_snapshot = argv[i]; }\n"
+      "    }\n"
+      "    else if(!strcmp(cp, \"-r\") || !strcmp(cp, \"--read-snapshot\")) {\n"
+      "      if(++i == argc || argv[i][0] == '-') { no_param(cp); } else { read_snapshot = argv[i]; }\n"
+      "    }\n";
+
+  s <<
       "    else {\n"
       "      std::cerr << \"ERROR: bad parameter \" << cp << std::endl;\n"
       "      usage(argv[0]);\n"
@@ -269,11 +536,27 @@ gen_dump_application(std::ostream& s,
       "    return (EXIT_FAILURE);\n"
       "  }\n"
       "\n"
-      "  if(class_name.empty()) {\n"
+      "  if(class_name.empty() && !dump_all" << (options.m_snapshot ? " && write_snapshot == nullptr" : "") << ") {\n"
       "    std::cerr << \"ERROR: no class name provided\\n\";\n"
       "    return (EXIT_FAILURE);\n"
       "  }\n"
       "\n"
+      "  if(dump_all && (!class_name.empty() || *query != 0 || object_id != nullptr)) {\n"
+      "    std::cerr << \"ERROR: parameters -c, -q and -i cannot be used with -a\\n\";\n"
+      "    return (EXIT_FAILURE);\n"
+      "  }\n"
+      "\n"
+      "  DumpFunction dump_function = nullptr;\n"
+      "\n"
+      "  if(!class_name.empty()) {\n"
+      "    auto it = dump_functions.find(class_name);\n"
+      "    if(it == dump_functions.end()) {\n"
+      "      std::cerr << \"ERROR: do not know how to dump object of \" << class_name << \" class\\n\";\n"
+      "      return (EXIT_FAILURE);\n"
+      "    }\n"
+      "    dump_function = it->second;\n"
+      "  }\n"
+      "\n"
       "  if(*query != 0 && object_id != nullptr) {\n"
       "    std::cerr << \"ERROR: only one parameter -i or -q can be provided\\n\";\n"
       "    return (EXIT_FAILURE);\n"
@@ -281,6 +564,8 @@ gen_dump_application(std::ostream& s,
       "\n"
       "\n"
       "std::cout << std::boolalpha;\n"
+      "\n"
+      "  Timing timer;\n"
       "\n";
 
   if (conf_name)
@@ -288,92 +573,626 @@ gen_dump_application(std::ostream& s,
       s <<
           "  " << conf_name << " impl_conf;\n"
           "\n"
-          "  {\n"
+          "  for(unsigned int repeat = 0; repeat < repeat_count; ++repeat) {\n"
+          "    auto t1 = std::chrono::steady_clock::now();\n"
           "    dunedaq::conffwk::Configuration conf(db_name, &impl_conf);\n";
     }
   else
     {
       s <<
-          "  try {\n"
+          "  for(unsigned int repeat = 0; repeat < repeat_count; ++repeat) try {\n"
+          "    auto t1 = std::chrono::steady_clock::now();\n"
           "    dunedaq::conffwk::Configuration conf(db_name);\n";
     }
 
   s <<
+      "    auto t2 = std::chrono::steady_clock::now();\n"
+      "    timer.m_open.push_back(Timing::interval(t1, t2));\n"
       "\n"
       "    if(!conf.loaded()) {\n"
       "      std::cerr << \"Can not load database: \" << db_name << std::endl;\n"
       "      return (EXIT_FAILURE);\n"
-      "    }\n"
+      "    }\n";
+
+  if (options.m_snapshot)
+    {
+      s <<
+        "\n"
+        "    if(write_snapshot) {\n"
+        "      dunedaq::oksdalgen::SnapshotWriter writer;\n\n";
+
+      for (const auto& i : class_names)
+        {
+          std::string cname(cpp_ns_name);
+
+          if (!cname.empty())
+            cname += "::";
+
+          cname += i;
+
+          s <<
+            "      {\n"
+            "        std::vector<const " << cname << "*> objs;\n"
+            "        conf.get<" << cname << ">(objs, init_children);\n"
+            "        for(const auto& x : objs)\n"
+            "          writer.add(x);\n"
+            "      }\n\n";
+        }
+
+      s <<
+        "      std::ofstream f(write_snapshot, std::ios::binary);\n"
+        "      writer.save(f);\n"
+        "      f.close();\n\n"
+        "      if(!f) {\n"
+        "        std::cerr << \"ERROR: can not write snapshot file \" << write_snapshot << std::endl;\n"
+        "        return (EXIT_FAILURE);\n"
+        "      }\n\n"
+        "      return 0;\n"
+        "    }\n"
+        "\n"
+        "    if(read_snapshot) {\n"
+        "      std::ifstream f(read_snapshot, std::ios::binary);\n\n"
+        "      if(!f) {\n"
+        "        std::cerr << \"ERROR: can not open snapshot file \" << read_snapshot << std::endl;\n"
+        "        return (EXIT_FAILURE);\n"
+        "      }\n\n"
+        "      dunedaq::oksdalgen::SnapshotReader(conf).load(f);\n"
+        "    }\n";
+    }
+
+  s <<
       "    \n"
       "    std::vector< dunedaq::conffwk::ConfigObject > objects;\n"
+      "    std::vector< DumpFunction > functions;\n"
       "    \n"
-      "    if(object_id) {\n"
-      "      dunedaq::conffwk::ConfigObject obj;\n"
-      "      try {\n"
-      "        conf.get(class_name, object_id, obj, 1);\n"
+      "    auto by_uid = [](const dunedaq::conffwk::ConfigObject& o1, const dunedaq::conffwk::ConfigObject& o2) { return (o1.UID() < o2.UID()); };\n"
+      "    \n"
+      "    if(dump_all) {\n"
+      "      std::map< std::string, std::vector< dunedaq::conffwk::ConfigObject > > all_objects;\n"
+      "      std::unordered_set< std::string > taken;\n"
+      "      \n"
+      "        // get objects of each class and of its derived classes not taken yet; the classes are processed derived classes first,\n"
+      "        // so an object of class without dump function is dumped by its nearest generated superclass; skip classes not defined by database schema\n"
+      "      \n"
+      "      for(const char * name : derived_first_classes) {\n"
+      "        std::vector< dunedaq::conffwk::ConfigObject > class_objects;\n"
+      "        try {\n"
+      "          conf.get(name, class_objects);\n"
+      "        }\n"
+      "        catch (dunedaq::conffwk::NotFound &) {\n"
+      "          continue;\n"
+      "        }\n"
+      "        auto& x = all_objects[name];\n"
+      "        for(const auto& o : class_objects)\n"
+      "          if(taken.insert(o.UID() + '@' + o.class_name()).second)\n"
+      "            x.push_back(o);\n"
       "      }\n"
-      "      catch (dunedaq::conffwk::NotFound & ex) {\n"
-      "        std::cerr << \"Can not get object \\'\" << object_id << \"\\' of class \\'\" << class_name << \"\\':\\n\" << ex << std::endl;\n"
-      "        return (EXIT_FAILURE);\n"
+      "      \n"
+      "      for(auto& x : all_objects) {\n"
+      "        std::stable_sort(x.second.begin(), x.second.end(), by_uid);\n"
+      "        objects.insert(objects.end(), x.second.begin(), x.second.end());\n"
+      "        functions.insert(functions.end(), x.second.size(), dump_functions.at(x.first));\n"
       "      }\n"
-      "      objects.push_back(obj);\n"
       "    }\n"
       "    else {\n"
-      "      try {\n"
-      "        conf.get(class_name, objects, query, 1);\n"
+      "      if(object_id) {\n"
+      "        dunedaq::conffwk::ConfigObject obj;\n"
+      "        try {\n"
+      "          conf.get(class_name, object_id, obj, 1);\n"
+      "        }\n"
+      "        catch (dunedaq::conffwk::NotFound & ex) {\n"
+      "          std::cerr << \"Can not get object \\'\" << object_id << \"\\' of class \\'\" << class_name << \"\\':\\n\" << ex << std::endl;\n"
+      "          return (EXIT_FAILURE);\n"
+      "        }\n"
+      "        objects.push_back(obj);\n"
       "      }\n"
-      "      catch (dunedaq::conffwk::NotFound & ex) {\n"
-      "        std::cerr << \"Can not get objects of class \\'\" << class_name << \"\\':\\n\" << ex << std::endl;\n"
-      "        return (EXIT_FAILURE);\n"
+      "      else {\n"
+      "        try {\n"
+      "          conf.get(class_name, objects, query, 1);\n"
+      "        }\n"
+      "        catch (dunedaq::conffwk::NotFound & ex) {\n"
+      "          std::cerr << \"Can not get objects of class \\'\" << class_name << \"\\':\\n\" << ex << std::endl;\n"
+      "          return (EXIT_FAILURE);\n"
+      "        }\n"
       "      }\n"
+      "      \n"
+      "      std::stable_sort(objects.begin(), objects.end(), by_uid);\n"
+      "      objects.erase(std::unique(objects.begin(), objects.end(), [](const dunedaq::conffwk::ConfigObject& o1, const dunedaq::conffwk::ConfigObject& o2) { return (o1.UID() == o2.UID()); }), objects.end());\n"
+      "      functions.assign(objects.size(), dump_function);\n"
       "    }\n"
       "    \n"
-      "    struct SortByUId {\n"
-      "      bool operator() (const dunedaq::conffwk::ConfigObject * o1, const dunedaq::conffwk::ConfigObject * o2) const {\n"
-      "        return (o1->UID() < o2->UID());\n"
-      "      };\n"
-      "    };\n"
-      "    \n"
-      "    std::set< dunedaq::conffwk::ConfigObject *, SortByUId > sorted_objects;\n"
-      "    \n"
-      "    for(auto& i : objects)\n"
-      "      sorted_objects.insert(&i);\n"
-      "    \n"
-      "    for(auto& i : sorted_objects) {\n";
+      "    timer.m_get.push_back(Timing::interval(t2, std::chrono::steady_clock::now()));\n"
+      "    \n";
 
-  for (std::list<std::string>::iterator i = class_names.begin(); i != class_names.end(); ++i)
-    {
-      const char * op = (i == class_names.begin() ? "if" : "else if");
-      std::string cname(cpp_ns_name);
+  if (options.m_json)
+    s <<
+      "    if(json_format && !no_print)\n"
+      "      std::cout << '[';\n"
+      "    \n";
 
-      if (!cname.empty())
-        cname += "::";
+  const char * json_parameter = (options.m_json ? ", dunedaq::oksdalgen::JsonWriter& json" : "");
+  const char * json_argument = (options.m_json ? ", json" : "");
 
-      cname += *i;
+  s <<
+      "      // initialize and print object with given index\n"
+      "\n"
+      "    auto dump = [&](std::size_t index, std::ostream& out" << json_parameter << ", Timing& t) {\n"
+      "      const auto t1 = std::chrono::steady_clock::now();\n"
+      "      const auto t2 = functions[index](conf, objects[index], init_children, !no_print, out" << (options.m_json ? ", json_format, index, json" : "") << ");\n"
+      "\n"
+      "      if(timing)\n"
+      "        t.add_object(repeat, objects[index].class_name(), t1, t2, std::chrono::steady_clock::now());\n"
+      "    };\n"
+      "\n"
+      "    if(threads_count <= 1) {\n" <<
+      (options.m_json ? "      dunedaq::oksdalgen::JsonWriter json;\n\n" : "") <<
+      "      for(std::size_t i = 0; i < objects.size(); ++i)\n"
+      "        dump(i, std::cout" << json_argument << ", timer);\n"
+      "    }\n"
+      "    else {\n"
+      "        // each thread formats contiguous slice of block into own buffer; the buffers are printed in order\n"
+      "\n"
+      "      const std::size_t block = threads_count * 4096;\n"
+      "      std::vector<Timing> timers(threads_count);\n"
+      "      std::mutex error_mutex;\n"
+      "      std::exception_ptr error;\n"
+      "\n"
+      "      for(std::size_t begin = 0; begin < objects.size() && !error; begin += block) {\n"
+      "        const std::size_t end = std::min(begin + block, objects.size());\n"
+      "        const std::size_t slice = (end - begin + threads_count - 1) / threads_count;\n"
+      "        std::vector<std::ostringstream> buffers(threads_count);\n"
+      "        std::vector<std::thread> workers;\n"
+      "\n"
+      "        for(unsigned int t = 0; t < threads_count; ++t)\n"
+      "          workers.emplace_back([&, t]() {\n" <<
+      (options.m_json ? "            dunedaq::oksdalgen::JsonWriter json;\n" : "") <<
+      "            buffers[t] << std::boolalpha;\n"
+      "            try {\n"
+      "              for(std::size_t i = std::min(begin + t * slice, end); i < std::min(begin + (t + 1) * slice, end); ++i)\n"
+      "                dump(i, buffers[t]" << json_argument << ", timers[t]);\n"
+      "            }\n"
+      "            catch (...) {\n"
+      "              std::lock_guard<std::mutex> scoped_lock(error_mutex);\n"
+      "              if(!error) error = std::current_exception();\n"
+      "            }\n"
+      "          });\n"
+      "\n"
+      "        for(auto& w : workers)\n"
+      "          w.join();\n"
+      "\n"
+      "          // on error the partial output of the block is discarded and the error is reported as by single thread\n"
+      "\n"
+      "        if(error)\n"
+      "          break;\n"
+      "\n"
+      "        for(const auto& b : buffers)\n"
+      "          std::cout << b.str();\n"
+      "      }\n"
+      "\n"
+      "      for(const auto& t : timers)\n"
+      "        timer.merge(repeat, t);\n"
+      "\n"
+      "      if(error)\n"
+      "        std::rethrow_exception(error);\n"
+      "    }\n";
 
-      s <<
-          "      " << op << "(class_name == \"" << *i << "\") {\n"
-          "        std::cout << *conf.get<" << cname << ">(*i, init_children) << std::endl;\n"
-          "      }\n";
-    }
+  if (options.m_json)
+    s <<
+      "    \n"
+      "    if(json_format && !no_print)\n"
+      "      std::cout << \"\\n]\" << std::endl;\n";
 
   s <<
-      "      else {\n"
-      "        std::cerr << \"ERROR: do not know how to dump object of \" << class_name << \" class\\n\";\n"
-      "        return (EXIT_FAILURE);\n"
-      "      }\n"
-      "    }\n"
       "  }\n"
       "  catch (dunedaq::conffwk::Exception & ex) {\n"
       "    std::cerr << \"Caught \" << ex << std::endl;\n"
       "    return (EXIT_FAILURE);\n"
       "  }\n"
       "\n"
+      "  if(timing)\n"
+      "    timer.report(repeat_count, init_children);\n"
+      "\n"
       "  return 0;\n"
       "}\n";
 }
 
 
+  /**
+   *  The function get_preload_function_name() returns name of generated
+   *  preloader function (e.g. "preload_dunedaq__coredal")
+   */
+
+std::string
+get_preload_function_name(const std::string& cpp_ns_name)
+{
+  return (cpp_ns_name.empty() ? std::string("preload") : std::string("preload_") + alnum_name(cpp_ns_name));
+}
+
+
+  /**
+   *  The function gen_preload_header() generates declaration of preloader.
+   */
+
+void
+gen_preload_header(std::ostream& s, const std::string& cpp_ns_name)
+{
+  const std::string name(get_preload_function_name(cpp_ns_name));
+  std::string guard(name);
+  std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+
+  s <<
+    "  // *** this file is generated by oksdalgen, do not modify it ***\n"
+    "\n"
+    "#ifndef _" << guard << "_H_\n"
+    "#define _" << guard << "_H_\n"
+    "\n"
+    "#include <cstddef>\n"
+    "\n"
+    "namespace dunedaq {\n"
+    "  namespace conffwk {\n"
+    "    class Configuration;\n"
+    "  }\n"
+    "}\n"
+    "\n";
+
+  const int ns_level = open_cpp_namespace(s, cpp_ns_name);
+  const std::string dx(int2dx(ns_level));
+
+  s << (ns_level ? "\n" : "") <<
+    dx << "  /**\n" <<
+    dx << "   * \\brief Create and initialize all objects of classes generated in " << (cpp_ns_name.empty() ? std::string("global namespace") : std::string("namespace \"") + cpp_ns_name + '\"') << ".\n" <<
+    dx << "   *\n" <<
+    dx << "   * The objects are created by single thread and initialized by given number of threads\n" <<
+    dx << "   * (0 means number of hardware threads). The objects are distributed between queues of\n" <<
+    dx << "   * the threads in advance; a thread, which emptied own queue, takes objects from the others.\n" <<
+    dx << "   *\n" <<
+    dx << "   * \\param db       the configuration\n" <<
+    dx << "   * \\param threads  the number of threads\n" <<
+    dx << "   * \\return         number of initialized objects\n" <<
+    dx << "   * \\throw          the first exception thrown by initialization of objects\n" <<
+    dx << "   */\n"
+    "\n" <<
+    dx << "std::size_t " << name << "(dunedaq::conffwk::Configuration& db, unsigned int threads = 0);\n"
+    "\n";
+
+  close_cpp_namespace(s, ns_level);
+
+  s << (ns_level ? "\n" : "") << "#endif\n";
+}
+
+
+  /**
+   *  The function gen_preload_body() generates preloader, which gets config objects
+   *  of generated classes, creates DAL objects and initializes them in parallel.
+   *  The class names are ordered so that each class precedes its superclasses.
+   */
+
+void
+gen_preload_body(std::ostream& s, const std::list<std::string>& class_names, const std::string& cpp_ns_name, const std::string& cpp_hdr_dir)
+{
+  const std::string name(get_preload_function_name(cpp_ns_name));
+  const std::string prefix(cpp_hdr_dir.empty() ? std::string() : cpp_hdr_dir + '/');
+
+  s <<
+    "  // *** this file is generated by oksdalgen, do not modify it ***\n"
+    "\n"
+    "#include <algorithm>\n"
+    "#include <deque>\n"
+    "#include <exception>\n"
+    "#include <mutex>\n"
+    "#include <string>\n"
+    "#include <thread>\n"
+    "#include <unordered_set>\n"
+    "#include <vector>\n"
+    "\n"
+    "#include \"conffwk/ConfigObject.hpp\"\n"
+    "#include \"conffwk/Configuration.hpp\"\n"
+    "#include \"conffwk/Errors.hpp\"\n"
+    "\n"
+    "#include \"" << prefix << name << ".hpp\"\n"
+    "\n";
+
+  for (const auto& i : class_names)
+    s << "#include \"" << prefix << i << ".hpp\"\n";
+
+  s <<
+    "\n"
+    "namespace {\n"
+    "\n"
+    "    // initialization of one object\n"
+    "\n"
+    "  struct PreloadTask\n"
+    "  {\n"
+    "    void (*m_preload)(const void *);\n"
+    "    const void * m_object;\n"
+    "  };\n"
+    "\n"
+    "  template<class T>\n"
+    "    void\n"
+    "    preload_object(const void * obj)\n"
+    "    {\n"
+    "      static_cast<const T *>(obj)->preload();\n"
+    "    }\n"
+    "\n"
+    "    // create objects of given class and of its derived classes, which are not created yet; the classes are\n"
+    "    // processed derived classes first, so an object of class without generated code is created as object\n"
+    "    // of its nearest generated superclass; classes not defined by database schema are skipped\n"
+    "\n"
+    "  template<class T>\n"
+    "    void\n"
+    "    create_objects(dunedaq::conffwk::Configuration& db, const std::string& class_name, std::unordered_set<std::string>& created, std::vector<PreloadTask>& tasks)\n"
+    "    {\n"
+    "      std::vector<dunedaq::conffwk::ConfigObject> objects;\n"
+    "\n"
+    "      try\n"
+    "        {\n"
+    "          db.get(class_name, objects);\n"
+    "        }\n"
+    "      catch (dunedaq::conffwk::NotFound &)\n"
+    "        {\n"
+    "          return;  // the class is not defined by database schema\n"
+    "        }\n"
+    "\n"
+    "      for (auto& obj : objects)\n"
+    "        if (created.insert(obj.UID() + '@' + obj.class_name()).second)\n"
+    "          tasks.push_back(PreloadTask{&preload_object<T>, static_cast<const void *>(db.get<T>(obj, false, false))});\n"
+    "    }\n"
+    "\n"
+    "    // queue of tasks of one thread filled before the threads start; the owner takes tasks from the back,\n"
+    "    // other threads having empty queues take them from the front\n"
+    "\n"
+    "  class PreloadQueue\n"
+    "  {\n"
+    "  public:\n"
+    "\n"
+    "    void\n"
+    "    push(const PreloadTask& task)\n"
+    "    {\n"
+    "      m_tasks.push_back(task);\n"
+    "    }\n"
+    "\n"
+    "    bool\n"
+    "    pop(PreloadTask& task)\n"
+    "    {\n"
+    "      std::lock_guard scoped_lock(m_mutex);\n"
+    "\n"
+    "      if (m_tasks.empty())\n"
+    "        return false;\n"
+    "\n"
+    "      task = m_tasks.back();\n"
+    "      m_tasks.pop_back();\n"
+    "      return true;\n"
+    "    }\n"
+    "\n"
+    "    bool\n"
+    "    steal(PreloadTask& task)\n"
+    "    {\n"
+    "      std::lock_guard scoped_lock(m_mutex);\n"
+    "\n"
+    "      if (m_tasks.empty())\n"
+    "        return false;\n"
+    "\n"
+    "      task = m_tasks.front();\n"
+    "      m_tasks.pop_front();\n"
+    "      return true;\n"
+    "    }\n"
+    "\n"
+    "  private:\n"
+    "\n"
+    "    std::mutex m_mutex;\n"
+    "    std::deque<PreloadTask> m_tasks;\n"
+    "  };\n"
+    "\n"
+    "}\n"
+    "\n"
+    "std::size_t\n" <<
+    (cpp_ns_name.empty() ? std::string() : cpp_ns_name + "::") << name << "(dunedaq::conffwk::Configuration& db, unsigned int threads)\n"
+    "{\n"
+    "  std::vector<PreloadTask> tasks;\n"
+    "  std::unordered_set<std::string> created;\n"
+    "\n"
+    "    // create objects by single thread\n"
+    "\n";
+
+  for (const auto& i : class_names)
+    s << "  create_objects<" << (cpp_ns_name.empty() ? std::string() : cpp_ns_name + "::") << i << ">(db, \"" << i << "\", created, tasks);\n";
+
+  s <<
+    "\n"
+    "    // initialize objects by several threads; no new tasks are created, so a thread stops when all queues are empty\n"
+    "\n"
+    "  if (threads == 0)\n"
+    "    threads = std::max(std::thread::hardware_concurrency(), 1U);\n"
+    "\n"
+    "  std::vector<PreloadQueue> queues(threads);\n"
+    "\n"
+    "  for (std::size_t i = 0; i < tasks.size(); ++i)\n"
+    "    queues[i % threads].push(tasks[i]);\n"
+    "\n"
+    "  std::mutex error_mutex;\n"
+    "  std::exception_ptr error;\n"
+    "\n"
+    "  auto worker = [&](unsigned int id)\n"
+    "    {\n"
+    "      PreloadTask task;\n"
+    "\n"
+    "      while (true)\n"
+    "        {\n"
+    "          bool found = queues[id].pop(task);\n"
+    "\n"
+    "          for (unsigned int i = 1; !found && i < threads; ++i)\n"
+    "            found = queues[(id + i) % threads].steal(task);\n"
+    "\n"
+    "          if (!found)\n"
+    "            return;\n"
+    "\n"
+    "          try\n"
+    "            {\n"
+    "              task.m_preload(task.m_object);\n"
+    "            }\n"
+    "          catch (...)\n"
+    "            {\n"
+    "              std::lock_guard scoped_lock(error_mutex);\n"
+    "              if (!error)\n"
+    "                error = std::current_exception();\n"
+    "            }\n"
+    "        }\n"
+    "    };\n"
+    "\n"
+    "  std::vector<std::thread> pool;\n"
+    "\n"
+    "  for (unsigned int i = 1; i < threads; ++i)\n"
+    "    pool.emplace_back(worker, i);\n"
+    "\n"
+    "  worker(0);\n"
+    "\n"
+    "  for (auto& t : pool)\n"
+    "    t.join();\n"
+    "\n"
+    "  if (error)\n"
+    "    std::rethrow_exception(error);\n"
+    "\n"
+    "  return tasks.size();\n"
+    "}\n";
+}
+
+
+
+  /**
+   *  The function get_umbrella_header_name() returns name of generated
+   *  header including all classes without extension (e.g. "dunedaq__coredal")
+   */
+
+std::string
+get_umbrella_header_name(const std::string& cpp_ns_name)
+{
+  return (cpp_ns_name.empty() ? std::string("all_classes") : alnum_name(cpp_ns_name));
+}
+
+
+  /**
+   *  The function gen_umbrella_header() generates header including
+   *  headers of all generated classes in the order of their names.
+   */
+
+void
+gen_umbrella_header(std::ostream& s, const std::list<std::string>& class_names, const std::string& cpp_ns_name, const std::string& cpp_hdr_dir)
+{
+  std::string guard(get_umbrella_header_name(cpp_ns_name));
+  std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+
+  const std::string prefix(cpp_hdr_dir.empty() ? std::string() : cpp_hdr_dir + '/');
+
+  s <<
+    "// *** this file is generated by oksdalgen, do not modify it ***\n"
+    "\n"
+    "#ifndef _" << guard << "_ALL_H_\n"
+    "#define _" << guard << "_ALL_H_\n"
+    "\n";
+
+  for (const auto& i : std::set<std::string>(class_names.begin(), class_names.end()))
+    s << "#include \"" << prefix << alnum_name(i) << ".hpp\"\n";
+
+  s <<
+    "\n"
+    "#endif\n";
+}
+
+
+  /**
+   *  The function gen_pch_list() writes headers to be precompiled for
+   *  generated classes, one per line in the form accepted by CMake
+   *  target_precompile_headers(), e.g.:
+   *
+   *    file(STRINGS ${dir}/prelude_dunedaq__coredal.pch pch)
+   *    target_precompile_headers(target PRIVATE ${pch})
+   *
+   *  Besides the prelude header these are the headers used by all generated
+   *  implementation files. The umbrella header is not listed, since it
+   *  changes with any class.
+   */
+
+void
+gen_pch_list(std::ostream& s, const std::string& cpp_hdr_dir, const std::string& prelude_name)
+{
+  s <<
+    "<conffwk/ConfigObject.hpp>\n"
+    "<conffwk/DalFactory.hpp>\n"
+    "<conffwk/DalObjectPrint.hpp>\n"
+    "<conffwk/Errors.hpp>\n"
+    "<logging/Logging.hpp>\n"
+    "<";
+
+  if (!cpp_hdr_dir.empty())
+    s << cpp_hdr_dir << '/';
+
+  s << prelude_name << ".hpp>\n";
+}
+
+
+  /**
+   *  The function get_fwd_header_name() returns name of generated header
+   *  with forward declarations without extension (e.g. "dunedaq__coredal_fwd")
+   */
+
+std::string
+get_fwd_header_name(const std::string& cpp_ns_name)
+{
+  return get_umbrella_header_name(cpp_ns_name) + "_fwd";
+}
+
+
+  /**
+   *  The function gen_fwd_header() generates header with forward declarations
+   *  of all generated classes and of conffwk classes used by their interfaces.
+   *  It can be used instead of class headers, when complete types are not required.
+   */
+
+void
+gen_fwd_header(std::ostream& s, const std::list<std::string>& class_names, const std::string& cpp_ns_name)
+{
+  std::string guard(get_fwd_header_name(cpp_ns_name));
+  std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+
+  NameSpaceInfo ns_info;
+
+  ns_info.add("dunedaq::conffwk", "ConfigObject");
+  ns_info.add("dunedaq::conffwk", "Configuration");
+  ns_info.add("dunedaq::conffwk", "DalObject");
+
+  for (const auto& i : class_names)
+    ns_info.add(cpp_ns_name, alnum_name(i));
+
+  s <<
+    "// *** this file is generated by oksdalgen, do not modify it ***\n"
+    "\n"
+    "#ifndef _" << guard << "_H_\n"
+    "#define _" << guard << "_H_\n"
+    "\n";
+
+  ns_info.print(s, 0);
+
+  s <<
+    "\n"
+    "#endif\n";
+}
+
+
+  /**
+   *  The function gen_unity_file() generates translation unit including
+   *  implementation files of given classes.
+   */
+
+void
+gen_unity_file(std::ostream& s, const std::vector<std::string>& class_names)
+{
+  s << "  // *** this file is generated by oksdalgen, do not modify it ***\n\n";
+
+  for (const auto& i : class_names)
+    s << "#include \"" << alnum_name(i) << ".cpp\"\n";
+}
+
+
 void
 write_info_file(std::ostream& s,
                 const std::string& cpp_namespace,
@@ -395,6 +1214,79 @@ write_info_file(std::ostream& s,
 }
 
 
+  /**
+   *  The manifest file keeps fingerprints of generated classes
+   *  used to skip generation of unchanged classes in incremental mode.
+   */
+
+void
+read_manifest_file(const std::string& file_name, std::map<std::string, std::string>& fingerprints)
+{
+  std::ifstream f(file_name.c_str());
+
+  std::string s;
+  while (std::getline(f, s))
+    {
+      if (s.find("//") == 0)
+        continue;
+
+      std::string::size_type idx = s.find(' ');
+      if (idx != std::string::npos)
+        fingerprints[s.substr(idx + 1)] = s.substr(0, idx);
+      else
+        std::cerr << "Failed to parse line \"" << s << "\" of manifest file \"" << file_name << "\"\n";
+    }
+}
+
+void
+write_manifest_file(std::ostream& s, const std::map<std::string, std::string>& fingerprints)
+{
+  s << "// the file is generated by oksdalgen utility\n"
+      "// *** do not modify the file ***\n";
+
+  for (const auto& i : fingerprints)
+    s << i.second << ' ' << i.first << std::endl;
+}
+
+bool
+file_exists(const std::string& file_name)
+{
+  return static_cast<bool>(std::ifstream(file_name.c_str()));
+}
+
+
+  /**
+   *  The function write_file_if_changed() does not touch existing file
+   *  with the same contents to preserve its modification time.
+   */
+
+bool
+write_file_if_changed(const std::string& file_name, const std::string& data)
+{
+    {
+      std::ifstream f(file_name.c_str(), std::ios::binary);
+
+      if (f)
+        {
+          std::ostringstream old;
+          old << f.rdbuf();
+          if (old.str() == data)
+            return true;
+        }
+    }
+
+  std::ofstream f(file_name.c_str(), std::ios::binary);
+
+  if (!f || !(f << data) || !f.flush())
+    {
+      std::cerr << "ERROR: can not create file \"" << file_name << "\"\n";
+      return false;
+    }
+
+  return true;
+}
+
+
   /**
    *  The function get_full_cpp_class_name() returns name of class
    *  with it's namespace (e.g. "NAMESPACE_A::CLASS_X")
@@ -465,18 +1357,20 @@ get_include_dir(const OksClass * c, const ClassInfo::Map& cl_info, const std::st
 //     }
 // }
 
-bool
-process_external_class(
-  ClassInfo::Map& cl_info,
-  const OksClass * c,
+  /**
+   *  The function build_external_class_index() parses the list of user-defined
+   *  classes and all oksdalgen info files found in the include directories.
+   *  If a class is described several times, the first description is used.
+   */
+
+void
+build_external_class_index(
+  ExternalClassIndex& index,
   const std::list<std::string>& include_dirs,
   const std::list<std::string>& user_classes,
   bool verbose)
 {
-  if (cl_info.find(c) != cl_info.end())
-    return true;
-
-  // process list of user-defined classes first
+  auto start = std::chrono::steady_clock::now();
 
   for (const auto &s : user_classes)
     {
@@ -500,26 +1394,7 @@ process_external_class(
       if (idx2 != std::string::npos)
         cpp_dir_name = s.substr(idx2 + 1);
 
-      if (class_name == c->get_name())
-        {
-          cl_info[c] = ClassInfo(cpp_ns_name, cpp_dir_name);
-          if (verbose)
-            {
-              std::cout << " * class " << c->get_name() << " is defined by user in ";
-
-              if (cpp_ns_name.empty())
-                std::cout << "global namespace";
-              else
-                std::cout << "namespace \"" << cpp_ns_name << '\"';
-
-              if (!cpp_dir_name.empty())
-                std::cout << " with \"" << cpp_dir_name << "\" include prefix";
-
-              std::cout << std::endl;
-            }
-
-          return true;
-        }
+      index.m_user_classes.emplace(class_name, ExternalClassIndex::Entry{cpp_ns_name, cpp_dir_name, ""});
     }
 
   // process oksdalgen files
@@ -527,7 +1402,7 @@ process_external_class(
   if (verbose)
     std::cout << "Looking for oksdalgen info files ...\n";
 
-  bool found_class_declaration = false;
+  unsigned int files_num = 0;
 
   for (const auto& i : include_dirs)
     {
@@ -541,9 +1416,10 @@ process_external_class(
           if (verbose)
             std::cout << " *** found file \"" << file_name << "\" ***\n";
 
+          files_num++;
+
           std::string cpp_ns_name;
           std::string cpp_dir_name;
-          // std::string java_pname;
           bool is_class = false;
 
           std::string s;
@@ -563,55 +1439,29 @@ process_external_class(
               else
                 {
                   const char s1[] = "c++-namespace=";
-                  std::string::size_type idx = s.find(s1);
-                  if (idx != std::string::npos)
+                  const char s2[] = "c++-header-dir-prefix=";
+
+                  if (s.find(s1) != std::string::npos)
                     {
                       cpp_ns_name = s.substr(sizeof(s1) - 1);
                       if (verbose)
                         std::cout << " - c++ namespace = \"" << cpp_ns_name << "\"\n";
                     }
+                  else if (s.find(s2) != std::string::npos)
+                    {
+                      cpp_dir_name = s.substr(sizeof(s2) - 1);
+                      if (verbose)
+                        std::cout << " - c++ header dir prefix name = \"" << cpp_dir_name << "\"\n";
+                    }
+                  else if (is_class)
+                    {
+                      std::string cname = s.substr(2);
+                      if (index.m_info_classes.emplace(cname, ExternalClassIndex::Entry{cpp_ns_name, cpp_dir_name, file_name}).second == false && verbose)
+                        std::cout << " - skip class \"" << cname << "\" declaration\n";
+                    }
                   else
                     {
-                      const char s2[] = "c++-header-dir-prefix=";
-                      std::string::size_type idx = s.find(s2);
-                      if (idx != std::string::npos)
-                        {
-                          cpp_dir_name = s.substr(sizeof(s2) - 1);
-                          if (verbose)
-                            std::cout << " - c++ header dir prefix name = \"" << cpp_dir_name << "\"\n";
-                        }
-                      // else
-                        // {
-                        //   const char s3[] = "java-package-name=";
-                        //   std::string::size_type idx = s.find(s3);
-                        //   if (idx != std::string::npos)
-                        //     {
-                        //       java_pname = s.substr(sizeof(s3) - 1);
-                        //       if (verbose)
-                        //         std::cout << " - java package name = \"" << java_pname << "\"\n";
-                        //     }
-                          else if (is_class)
-                            {
-                              std::string cname = s.substr(2);
-                              OksClass * cl = c->get_kernel()->find_class(cname);
-                              if (cl && cl_info.find(cl) == cl_info.end())
-                                {
-                                  cl_info[cl] = ClassInfo(cpp_ns_name, cpp_dir_name);
-                                  if (verbose)
-                                    std::cout << " * class " << cl->get_name() << " is defined by " << file_name << " in namespace \"" << cpp_ns_name << "\" with include prefix \"" << cpp_dir_name << "\"\n";
-                                  if (cl == c)
-                                    found_class_declaration = true;
-                                }
-                              else if (verbose)
-                                {
-                                  std::cout << " - skip class \"" << cname << "\" declaration\n";
-                                }
-                            }
-                          else
-                            {
-                              std::cerr << "Failed to parse line \"" << s << "\"\n";
-                            }
-                        // }
+                      std::cerr << "Failed to parse line \"" << s << "\"\n";
                     }
                 }
             }
@@ -622,6 +1472,84 @@ process_external_class(
         }
     }
 
+  if (verbose)
+    std::cout << "Index of " << index.m_user_classes.size() << " user-defined classes and " << index.m_info_classes.size() << " classes from "
+              << files_num << " oksdalgen info files is built in "
+              << std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000. << " ms\n";
+}
+
+
+  /**
+   *  The function process_external_class() finds description of class
+   *  which is not generated in the index of external classes.
+   *  The first time a class is searched among classes of oksdalgen info files,
+   *  all of them which are known to the OKS kernel are put into the classes info.
+   */
+
+bool
+process_external_class(
+  ClassInfo::Map& cl_info,
+  const OksClass * c,
+  ExternalClassIndex& index,
+  bool verbose)
+{
+  if (cl_info.find(c) != cl_info.end())
+    return true;
+
+  // process list of user-defined classes first
+
+  ExternalClassIndex::Map::const_iterator x = index.m_user_classes.find(c->get_name());
+
+  if (x != index.m_user_classes.end())
+    {
+      const std::string& cpp_ns_name = x->second.m_namespace;
+      const std::string& cpp_dir_name = x->second.m_include_prefix;
+
+      cl_info[c] = ClassInfo(cpp_ns_name, cpp_dir_name);
+      if (verbose)
+        {
+          std::cout << " * class " << c->get_name() << " is defined by user in ";
+
+          if (cpp_ns_name.empty())
+            std::cout << "global namespace";
+          else
+            std::cout << "namespace \"" << cpp_ns_name << '\"';
+
+          if (!cpp_dir_name.empty())
+            std::cout << " with \"" << cpp_dir_name << "\" include prefix";
+
+          std::cout << std::endl;
+        }
+
+      return true;
+    }
+
+  // process classes of oksdalgen files
+
+  if (index.m_info_classes_registered)
+    return false;
+
+  index.m_info_classes_registered = true;
+
+  bool found_class_declaration = false;
+
+  for (const auto& i : index.m_info_classes)
+    {
+      OksClass * cl = c->get_kernel()->find_class(i.first);
+      if (cl && cl_info.find(cl) == cl_info.end())
+        {
+          cl_info[cl] = ClassInfo(i.second.m_namespace, i.second.m_include_prefix);
+          if (verbose)
+            std::cout << " * class " << cl->get_name() << " is defined by " << i.second.m_source << " in namespace \"" << i.second.m_namespace << "\" with include prefix \"" << i.second.m_include_prefix << "\"\n";
+          if (cl == c)
+            found_class_declaration = true;
+        }
+      else if (verbose)
+        {
+          std::cout << " - skip class \"" << i.first << "\" declaration\n";
+        }
+    }
+
   return found_class_declaration;
 }
 
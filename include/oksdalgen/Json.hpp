@@ -0,0 +1,206 @@
+/**
+ *  JSON writer used by DAL classes generated by oksdalgen with --json option.
+ *
+ *  The header is installed with oksdalgen and included by generated
+ *  headers, so all DALs use the same definitions.
+ */
+
+#ifndef OKSDALGEN_INCLUDE_OKSDALGEN_JSON_HPP_
+#define OKSDALGEN_INCLUDE_OKSDALGEN_JSON_HPP_
+
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace dunedaq {
+  namespace oksdalgen {
+
+      // The JSON writer appends text to its buffer, which can be reused after clear().
+
+    class JsonWriter
+    {
+    public:
+
+      void clear() noexcept { m_data.clear(); m_need_comma = false; }
+      const std::string& str() const noexcept { return m_data; }
+
+      void begin_object() { separator(); m_data.push_back('{'); m_need_comma = false; }
+      void end_object() { m_data.push_back('}'); m_need_comma = true; }
+      void begin_array() { separator(); m_data.push_back('['); m_need_comma = false; }
+      void end_array() { m_data.push_back(']'); m_need_comma = true; }
+
+      void
+      key(std::string_view name)
+      {
+        separator();
+        append_string(name);
+        m_data.push_back(':');
+        m_need_comma = false;
+      }
+
+      void null() { separator(); m_data.append("null"); m_need_comma = true; }
+      void value(bool v) { separator(); m_data.append(v ? "true" : "false"); m_need_comma = true; }
+      void value(std::string_view v) { separator(); append_string(v); m_need_comma = true; }
+      void value(const std::string& v) { value(std::string_view(v)); }
+      void value(const char * v) { value(std::string_view(v)); }
+
+        // integers are written in decimal format as numbers, in hexadecimal and octal formats as strings
+
+      template<class T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+        void
+        value(T v, int base = 10)
+        {
+          char buf[32];
+          char * p = buf;
+
+          if (base == 16)
+            *p++ = '0', *p++ = 'x';
+          else if (base == 8)
+            *p++ = '0';
+
+          if (base == 10)
+            p = std::to_chars(p, buf + sizeof(buf), v).ptr;
+          else
+            p = std::to_chars(p, buf + sizeof(buf), static_cast<std::make_unsigned_t<T>>(v), base).ptr;
+
+          separator();
+
+          if (base != 10)
+            m_data.push_back('"');
+
+          m_data.append(buf, p - buf);
+
+          if (base != 10)
+            m_data.push_back('"');
+
+          m_need_comma = true;
+        }
+
+      template<class T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+        void
+        value(T v, int = 10)
+        {
+          if (!std::isfinite(v))
+            return null();
+
+          char buf[32];
+          const int len = snprintf(buf, sizeof(buf), "%.*g", std::numeric_limits<T>::max_digits10, static_cast<double>(v));
+          separator();
+          m_data.append(buf, len);
+          m_need_comma = true;
+        }
+
+      template<class T>
+        void
+        value(const std::vector<T>& v, int base = 10)
+        {
+          begin_array();
+
+          for (const T& x : v)
+            {
+              if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+                value(x, base);
+              else
+                value(x);
+            }
+
+          end_array();
+        }
+
+        // relationships are written by identities of referenced objects or as nested objects
+
+      template<class T>
+        void
+        object_id(const T * obj)
+        {
+          if (obj)
+            value(obj->UID());
+          else
+            null();
+        }
+
+      template<class T>
+        void
+        object_id(const std::vector<const T *>& objs)
+        {
+          begin_array();
+          for (const auto& x : objs)
+            object_id(x);
+          end_array();
+        }
+
+      template<class T>
+        void
+        object(const T * obj)
+        {
+          if (obj)
+            obj->write_json(*this);
+          else
+            null();
+        }
+
+      template<class T>
+        void
+        object(const std::vector<const T *>& objs)
+        {
+          begin_array();
+          for (const auto& x : objs)
+            object(x);
+          end_array();
+        }
+
+    private:
+
+      void
+      separator()
+      {
+        if (m_need_comma)
+          m_data.push_back(',');
+      }
+
+      void
+      append_string(std::string_view v)
+      {
+        static const char hex[] = "0123456789abcdef";
+
+        m_data.push_back('"');
+
+        for (char c : v)
+          {
+            switch (c)
+              {
+                case '"':  m_data.append("\\\""); break;
+                case '\\': m_data.append("\\\\"); break;
+                case '\n': m_data.append("\\n"); break;
+                case '\r': m_data.append("\\r"); break;
+                case '\t': m_data.append("\\t"); break;
+                default:
+                  if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                      m_data.append("\\u00");
+                      m_data.push_back(hex[c >> 4]);
+                      m_data.push_back(hex[c & 0xf]);
+                    }
+                  else
+                    {
+                      m_data.push_back(c);
+                    }
+              }
+          }
+
+        m_data.push_back('"');
+      }
+
+      std::string m_data;
+      bool m_need_comma = false;
+    };
+
+  }
+}
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ *  Descriptors of attributes and relationships of DAL classes generated by
+ *  oksdalgen with --reflection option and the functions to visit them.
+ *
+ *  The header is installed with oksdalgen and included by generated
+ *  headers, so all DALs use the same definitions.
+ */
+
+#ifndef OKSDALGEN_INCLUDE_OKSDALGEN_REFLECTION_HPP_
+#define OKSDALGEN_INCLUDE_OKSDALGEN_REFLECTION_HPP_
+
+#include <stdint.h>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace dunedaq {
+  namespace oksdalgen {
+
+    enum class Format : uint8_t { Dec, Hex, Oct };
+
+    template<class G>
+      struct AttributeDescriptor
+      {
+        std::string_view m_name;       // name of attribute
+        std::string_view m_type;       // OKS type of attribute
+        bool m_is_multi_value;
+        Format m_format;               // output format of integers
+        G m_get;                       // pointer to getter
+
+        template<class C>
+          constexpr decltype(auto) get(const C& obj) const { return (obj.*m_get)(); }
+      };
+
+    template<class G>
+      struct RelationshipDescriptor
+      {
+        std::string_view m_name;       // name of relationship
+        std::string_view m_class;      // OKS class of relationship
+        bool m_is_multi_value;
+        bool m_is_composite;
+        G m_get;                       // pointer to getter
+
+        template<class C>
+          constexpr decltype(auto) get(const C& obj) const { return (obj.*m_get)(); }
+      };
+
+    template<class G>
+      constexpr AttributeDescriptor<G>
+      make_attribute_descriptor(std::string_view name, std::string_view type, bool is_multi_value, Format format, G get) noexcept
+      {
+        return AttributeDescriptor<G>{name, type, is_multi_value, format, get};
+      }
+
+    template<class G>
+      constexpr RelationshipDescriptor<G>
+      make_relationship_descriptor(std::string_view name, std::string_view class_name, bool is_multi_value, bool is_composite, G get) noexcept
+      {
+        return RelationshipDescriptor<G>{name, class_name, is_multi_value, is_composite, get};
+      }
+
+      // call f(descriptor) for attributes of class C and of its superclasses (superclasses first, each once)
+
+    template<class C, class F>
+      constexpr void
+      for_each_direct_attribute(F&& f)
+      {
+        std::apply([&](const auto&... d) { (f(d), ...); }, C::reflect_attributes());
+      }
+
+    template<class C, class F>
+      constexpr void
+      for_each_attribute(F&& f)
+      {
+        std::apply([&](auto... base) { (for_each_direct_attribute<std::remove_const_t<std::remove_pointer_t<decltype(base)>>>(f), ...); }, C::reflect_all_superclasses());
+        for_each_direct_attribute<C>(f);
+      }
+
+      // call f(descriptor) for relationships of class C and of its superclasses (superclasses first, each once)
+
+    template<class C, class F>
+      constexpr void
+      for_each_direct_relationship(F&& f)
+      {
+        std::apply([&](const auto&... d) { (f(d), ...); }, C::reflect_relationships());
+      }
+
+    template<class C, class F>
+      constexpr void
+      for_each_relationship(F&& f)
+      {
+        std::apply([&](auto... base) { (for_each_direct_relationship<std::remove_const_t<std::remove_pointer_t<decltype(base)>>>(f), ...); }, C::reflect_all_superclasses());
+        for_each_direct_relationship<C>(f);
+      }
+
+  }
+}
+
+#endif
@@ -0,0 +1,475 @@
+/**
+ *  Writer and reader of binary snapshot used by DAL classes generated by
+ *  oksdalgen with --snapshot option.
+ *
+ *  The header is installed with oksdalgen and included by generated
+ *  headers, so all DALs use the same definitions.
+ */
+
+#ifndef OKSDALGEN_INCLUDE_OKSDALGEN_SNAPSHOT_HPP_
+#define OKSDALGEN_INCLUDE_OKSDALGEN_SNAPSHOT_HPP_
+
+#include <stdint.h>
+#include <cstring>
+#include <filesystem>
+#include <istream>
+#include <iterator>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "conffwk/Configuration.hpp"
+#include "conffwk/DalObject.hpp"
+#include "conffwk/Errors.hpp"
+
+namespace dunedaq {
+  namespace oksdalgen {
+
+      // The binary snapshot contains fingerprint of database (size and modification time of files
+      // containing added objects), table of objects (class name, identity, signature of class data
+      // and size of object data) and data of objects. The relationships are stored as indices
+      // in the table. Objects referenced, but not added to the snapshot, are stored in the table without
+      // data. The byte order and sizes of types are ones of the platform writing the snapshot.
+      // The snapshot does not replace the database: the objects are taken from loaded configuration
+      // and their init() reads the data from snapshot instead of database, while the snapshot is loaded.
+
+    template<class T> struct is_snapshot_vector : std::false_type {};
+    template<class T, class A> struct is_snapshot_vector<std::vector<T, A>> : std::true_type {};
+
+    inline constexpr char s_snapshot_magic[8] = { 'O', 'K', 'S', 'D', 'A', 'L', 'S', '2' };
+    inline constexpr uint32_t s_snapshot_null = 0xffffffff;
+
+      // size and modification time of database file; both are 0, if the file is not accessible
+
+    inline std::pair<uint64_t, int64_t>
+    get_file_stamp(const std::string& name)
+    {
+      std::error_code ec;
+
+      const uint64_t size = std::filesystem::file_size(name, ec);
+      if (ec)
+        return {0, 0};
+
+      const auto mtime = std::filesystem::last_write_time(name, ec);
+      if (ec)
+        return {0, 0};
+
+      return {size, static_cast<int64_t>(mtime.time_since_epoch().count())};
+    }
+
+    class SnapshotWriter
+    {
+    public:
+
+        // add object and data of its class (objects of derived classes have to be added using their classes)
+
+      template<class T>
+        void
+        add(const T * obj)
+        {
+          if (obj->class_name() == T::s_class_name)
+            {
+              Object& o = m_objects[index(obj)];
+              o.m_ptr = obj;
+              o.m_signature = T::__snapshot_signature;
+              o.m_write = [](const void * p, SnapshotWriter& out) { static_cast<const T *>(p)->write_snapshot(out); };
+              m_files.insert(obj->config_object().contained_in());
+            }
+        }
+
+        // write snapshot of added objects
+
+      void
+      save(std::ostream& s)
+      {
+        std::vector<std::string> data;
+
+        // the table grows when data of objects reference objects not added yet
+
+        for (std::size_t i = 0; i < m_objects.size(); ++i)
+          {
+            m_data.clear();
+
+            if (auto write = m_objects[i].m_write)
+              write(m_objects[i].m_ptr, *this);
+
+            data.push_back(std::move(m_data));
+          }
+
+        m_data.assign(s_snapshot_magic, sizeof(s_snapshot_magic));
+        write(static_cast<uint32_t>(m_files.size()));
+
+        for (const auto& x : m_files)
+          {
+            const auto stamp = get_file_stamp(x);
+            write(x);
+            write(stamp.first);
+            write(stamp.second);
+          }
+
+        write(static_cast<uint32_t>(m_objects.size()));
+
+        for (std::size_t i = 0; i < m_objects.size(); ++i)
+          {
+            write(m_objects[i].m_class);
+            write(m_objects[i].m_uid);
+            write(m_objects[i].m_signature);
+            write(static_cast<uint64_t>(data[i].size()));
+          }
+
+        s.write(m_data.data(), m_data.size());
+
+        for (const auto& x : data)
+          s.write(x.data(), x.size());
+      }
+
+      template<class T>
+        void
+        write(const T& value)
+        {
+          if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+            m_data.append(reinterpret_cast<const char *>(&value), sizeof(T));
+          else if constexpr (std::is_same_v<T, std::string>)
+            {
+              write(static_cast<uint32_t>(value.size()));
+              m_data.append(value);
+            }
+          else if constexpr (is_snapshot_vector<T>::value)
+            {
+              write(static_cast<uint32_t>(value.size()));
+              for (const typename T::value_type& x : value)
+                write(x);
+            }
+          else
+            write(value.time_since_epoch().count());
+        }
+
+      template<class T>
+        void
+        write_object(const T * obj)
+        {
+          write(obj ? index(obj) : s_snapshot_null);
+        }
+
+      template<class T>
+        void
+        write_objects(const std::vector<const T *>& objs)
+        {
+          write(static_cast<uint32_t>(objs.size()));
+          for (const auto& x : objs)
+            write_object(x);
+        }
+
+    private:
+
+      struct Object
+      {
+        std::string m_class;
+        std::string m_uid;
+        uint64_t m_signature = 0;
+        const void * m_ptr = nullptr;
+        void (*m_write)(const void *, SnapshotWriter&) = nullptr;
+      };
+
+      uint32_t
+      index(const conffwk::DalObject * obj)
+      {
+        auto it = m_indices.emplace(obj, static_cast<uint32_t>(m_objects.size()));
+
+        if (it.second)
+          m_objects.push_back(Object{obj->class_name(), obj->UID()});
+
+        return it.first->second;
+      }
+
+      std::vector<Object> m_objects;
+      std::unordered_map<const conffwk::DalObject *, uint32_t> m_indices;
+      std::set<std::string> m_files;
+      std::string m_data;
+    };
+
+
+    class SnapshotReader
+    {
+    public:
+
+      struct Class
+      {
+        uint64_t m_signature;
+        const conffwk::DalObject * (*m_get)(conffwk::Configuration& db, const std::string& id);
+        void (*m_init)(const conffwk::DalObject * obj);
+      };
+
+        // called by generated classes when they are loaded
+
+      static void
+      register_class(const std::string& name, const Class& c)
+      {
+        classes()[name] = c;
+      }
+
+        // called by init() of generated classes: returns reader, if data of the object are read from snapshot
+
+      static SnapshotReader *
+      reading(const conffwk::DalObject * obj) noexcept
+      {
+        SnapshotReader * in = current();
+        return (in && in->m_current == obj) ? in : nullptr;
+      }
+
+      SnapshotReader(conffwk::Configuration& db) : m_db(db) {}
+
+        // read data of not yet read objects from snapshot instead of database; return number of such objects;
+        // if the database was modified after the snapshot was written, nothing is read from the snapshot
+
+      std::size_t
+      load(std::istream& s)
+      {
+        m_data.assign(std::istreambuf_iterator<char>(s), std::istreambuf_iterator<char>());
+        m_pos = sizeof(s_snapshot_magic);
+
+        if (m_data.compare(0, sizeof(s_snapshot_magic), s_snapshot_magic, sizeof(s_snapshot_magic)))
+          throw_error("bad snapshot format");
+
+        uint32_t count;
+        read(count);
+
+        for (uint32_t i = 0; i < count; ++i)
+          {
+            std::string file;
+            std::pair<uint64_t, int64_t> stamp;
+            read(file);
+            read(stamp.first);
+            read(stamp.second);
+
+            if (get_file_stamp(file) != stamp)
+              return 0;
+          }
+
+        read(count);
+        m_objects.resize(count);
+
+        for (auto& o : m_objects)
+          {
+            read(o.m_class);
+            read(o.m_uid);
+            read(o.m_signature);
+            read(o.m_size);
+          }
+
+        for (auto& o : m_objects)
+          {
+            if (o.m_size > m_data.size() - m_pos)
+              throw_error("unexpected end of snapshot");
+
+            o.m_pos = m_pos;
+            m_pos += o.m_size;
+          }
+
+        // get all objects having data first, so relationships between them point to these objects;
+        // the objects removed from database are skipped
+
+        for (auto& o : m_objects)
+          if (o.m_size)
+            {
+              auto c = classes().find(o.m_class);
+
+              if (c == classes().end())
+                continue;
+
+              if (c->second.m_signature != o.m_signature)
+                throw_error("schema of class \"" + o.m_class + "\" does not match snapshot");
+
+              try
+                {
+                  o.m_obj = c->second.m_get(m_db, o.m_uid);
+                  o.m_init = c->second.m_init;
+                }
+              catch (dunedaq::conffwk::NotFound &)
+                {
+                  ;
+                }
+            }
+
+        // objects read by init() while current reader is set take data from it; objects read already are skipped
+
+        struct Current
+        {
+          Current(SnapshotReader * in) { current() = in; }
+          ~Current() { current() = nullptr; }
+        } scoped_current(this);
+
+        std::size_t num = 0;
+
+        for (auto& o : m_objects)
+          if (o.m_init)
+            {
+              m_current = o.m_obj;
+              m_pos = o.m_pos;
+
+              o.m_init(o.m_obj);
+
+              m_current = nullptr;
+
+              if (m_pos != o.m_pos)
+                {
+                  if (m_pos != o.m_pos + o.m_size)
+                    throw_error("bad size of data of object \"" + o.m_uid + '@' + o.m_class + '\"');
+
+                  num++;
+                }
+            }
+
+        return num;
+      }
+
+      template<class T>
+        void
+        read(T& value)
+        {
+          if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+            {
+              memcpy(&value, get_data(sizeof(T)), sizeof(T));
+            }
+          else if constexpr (std::is_same_v<T, std::string>)
+            {
+              uint32_t len;
+              read(len);
+              value.assign(get_data(len), len);
+            }
+          else if constexpr (is_snapshot_vector<T>::value)
+            {
+              uint32_t len;
+              read(len);
+              value.clear();
+              value.reserve(len);
+              for (uint32_t i = 0; i < len; ++i)
+                {
+                  typename T::value_type x;
+                  read(x);
+                  value.push_back(std::move(x));
+                }
+            }
+          else
+            {
+              typename T::rep count;
+              read(count);
+              value = T(typename T::duration(count));
+            }
+        }
+
+      template<class T>
+        void
+        read_object(const T *& obj)
+        {
+          uint32_t idx;
+          read(idx);
+
+          if (idx == s_snapshot_null)
+            {
+              obj = nullptr;
+              return;
+            }
+
+          if (idx >= m_objects.size())
+            throw_error("bad index of object");
+
+          Object& o = m_objects[idx];
+
+          // objects without data in snapshot are read from database, when they are used; removed objects are skipped
+
+          if (o.m_obj == nullptr || (obj = dynamic_cast<const T *>(o.m_obj)) == nullptr)
+            {
+              try
+                {
+                  obj = m_db.get<T>(o.m_uid, false, false);
+                }
+              catch (dunedaq::conffwk::NotFound &)
+                {
+                  obj = nullptr;
+                  return;
+                }
+
+              if (o.m_obj == nullptr)
+                o.m_obj = obj;
+            }
+        }
+
+      template<class T>
+        void
+        read_objects(std::vector<const T *>& objs)
+        {
+          uint32_t len;
+          read(len);
+          objs.clear();
+          objs.reserve(len);
+          for (uint32_t i = 0; i < len; ++i)
+            {
+              const T * x;
+              read_object(x);
+              if (x)
+                objs.push_back(x);
+            }
+        }
+
+    private:
+
+      struct Object
+      {
+        std::string m_class;
+        std::string m_uid;
+        uint64_t m_signature = 0;
+        uint64_t m_size = 0;
+        std::size_t m_pos = 0;
+        const conffwk::DalObject * m_obj = nullptr;
+        void (*m_init)(const conffwk::DalObject * obj) = nullptr;
+      };
+
+      static SnapshotReader *&
+      current() noexcept
+      {
+        thread_local SnapshotReader * s_current = nullptr;
+        return s_current;
+      }
+
+      static std::map<std::string, Class>&
+      classes()
+      {
+        static std::map<std::string, Class> s_classes;
+        return s_classes;
+      }
+
+      const char *
+      get_data(std::size_t len)
+      {
+        if (len > m_data.size() - m_pos)
+          throw_error("unexpected end of snapshot");
+
+        const char * data = m_data.data() + m_pos;
+        m_pos += len;
+        return data;
+      }
+
+      [[noreturn]] static void
+      throw_error(const std::string& text)
+      {
+        throw dunedaq::conffwk::Generic(ERS_HERE, text.c_str());
+      }
+
+      conffwk::Configuration& m_db;
+      std::vector<Object> m_objects;
+      const conffwk::DalObject * m_current = nullptr;
+      std::string m_data;
+      std::size_t m_pos = 0;
+    };
+
+  }
+}
+
+#endif